@@ -0,0 +1,40 @@
+// Replaces the global operator new so benchmarks can count heap allocations.
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "Bench.hpp"
+
+namespace
+{
+    std::atomic<size_t> s_allocationCount = 0;
+}
+
+void* operator new(size_t size)
+{
+    s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* pMemory = std::malloc(size == 0 ? 1 : size))
+    {
+        return pMemory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pMemory) noexcept
+{
+    std::free(pMemory);
+}
+
+void operator delete(void* pMemory, size_t) noexcept
+{
+    std::free(pMemory);
+}
+
+namespace EverEngineBench
+{
+    size_t get_allocation_count()
+    {
+        return s_allocationCount.load(std::memory_order_relaxed);
+    }
+}
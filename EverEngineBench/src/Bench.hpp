@@ -0,0 +1,27 @@
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <chrono>
+#include <cstddef>
+
+namespace EverEngineBench
+{
+    using Clock = std::chrono::steady_clock;
+
+    inline double seconds_since(Clock::time_point start)
+    {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    // Heap allocations made through the global operator new so far.
+    size_t get_allocation_count();
+
+    // Each benchmark prints its own results and returns the process exit code.
+    int run_delegate(int argc, char** argv);
+    int run_event_queue(int argc, char** argv);
+    int run_event_queue_mpsc(int argc, char** argv);
+    int run_parallel_for(int argc, char** argv);
+    int run_render_queue(int argc, char** argv);
+}
+
+#endif // BENCH_HPP
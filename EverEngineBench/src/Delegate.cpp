@@ -0,0 +1,128 @@
+// Listener storage cost. Compares Delegate against the std::function that
+// used to wrap each listener, which was itself wrapped in a second
+// std::function taking BaseEvent&. The 24-byte capture is past libstdc++'s
+// 16-byte small buffer, the 8-byte one fits it.
+//
+// Then measures EventDispatcher::dispatch with 1, 4 and 16 listeners and the
+// allocations made to register them.
+
+#include <EverEngineCore/Delegate.hpp>
+#include <EverEngineCore/Event.hpp>
+
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+#include "Bench.hpp"
+
+namespace EverEngineBench
+{
+    namespace
+    {
+        using namespace EverEngine;
+
+        constexpr int Repeats = 3;
+        constexpr int ListenerCount = 16;
+        constexpr long CallsPerListener = 2000000;
+        constexpr long DispatchCalls = 20000000;
+
+        using DoubleFunction = std::function<void(BaseEvent&)>;
+        using ListenerDelegate = Delegate<void(BaseEvent&), 48>;
+
+        template<typename CallbackT>
+        double get_ns_per_call(std::vector<CallbackT>& callbacks, BaseEvent& event)
+        {
+            const Clock::time_point start = Clock::now();
+            for (long i = 0; i < CallsPerListener; ++i)
+            {
+                for (CallbackT& callback : callbacks)
+                {
+                    callback(event);
+                }
+            }
+            return seconds_since(start) * 1e9 / (static_cast<double>(CallsPerListener) * callbacks.size());
+        }
+
+        template<typename CallbackT>
+        void add_listener(std::vector<DoubleFunction>& functions, std::vector<ListenerDelegate>& delegates,
+            const CallbackT& callback)
+        {
+            std::function<void(EventMouseMoved&)> typed = callback;
+            functions.push_back([func = std::move(typed)](BaseEvent& e) { func(static_cast<EventMouseMoved&>(e)); });
+            delegates.push_back([func = callback](BaseEvent& e) { func(static_cast<EventMouseMoved&>(e)); });
+        }
+
+        void run_call_cost(double* sums)
+        {
+            for (bool bSmallCapture : { false, true })
+            {
+                std::vector<DoubleFunction> functions;
+                std::vector<ListenerDelegate> delegates;
+                for (int l = 0; l < ListenerCount; ++l)
+                {
+                    if (bSmallCapture)
+                    {
+                        add_listener(functions, delegates, [s = &sums[l]](EventMouseMoved& e) { *s += e.x; });
+                    }
+                    else
+                    {
+                        add_listener(functions, delegates,
+                            [s = &sums[l], k = l + 1.0, o = static_cast<double>(l)](EventMouseMoved& e) { *s += e.x * k + o; });
+                    }
+                }
+
+                EventMouseMoved event(1.0, 2.0);
+                for (int repeat = 0; repeat < Repeats; ++repeat)
+                {
+                    const double functionNs = get_ns_per_call(functions, event);
+                    const double delegateNs = get_ns_per_call(delegates, event);
+                    std::printf("%s capture: std::function x2 %5.2f ns/call, Delegate %5.2f ns/call\n",
+                        bSmallCapture ? " 8-byte" : "24-byte", functionNs, delegateNs);
+                }
+            }
+        }
+
+        void run_dispatch(double* sums)
+        {
+            for (int listenerCount : { 1, 4, 16 })
+            {
+                EventDispatcher dispatcher;
+                const size_t allocationsBefore = get_allocation_count();
+                for (int l = 0; l < listenerCount; ++l)
+                {
+                    dispatcher.add_event_listener<EventMouseMoved>(
+                        [s = &sums[l], k = l + 1.0, o = static_cast<double>(l)](EventMouseMoved& e) { *s += e.x * k + o; });
+                }
+                const size_t registrationAllocations = get_allocation_count() - allocationsBefore;
+
+                Event event = EventMouseMoved(1.0, 2.0);
+                const long dispatches = DispatchCalls / listenerCount;
+                for (int repeat = 0; repeat < Repeats; ++repeat)
+                {
+                    const Clock::time_point start = Clock::now();
+                    for (long i = 0; i < dispatches; ++i)
+                    {
+                        dispatcher.dispatch(event);
+                    }
+                    const double ns = seconds_since(start) * 1e9;
+                    std::printf("listeners=%2d: %5.2f ns per listener call, %zu allocations to register\n",
+                        listenerCount, ns / (static_cast<double>(dispatches) * listenerCount), registrationAllocations);
+                }
+            }
+        }
+    }
+
+    int run_delegate(int, char**)
+    {
+        double sums[ListenerCount] = {};
+
+        std::printf("Call cost, %d listeners in a vector\n", ListenerCount);
+        run_call_cost(sums);
+        std::printf("EventDispatcher::dispatch\n");
+        run_dispatch(sums);
+
+        volatile double sink = sums[0];
+        (void)sink;
+        return 0;
+    }
+}
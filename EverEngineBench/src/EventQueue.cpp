@@ -0,0 +1,67 @@
+// Single-threaded event throughput: each frame posts a batch of
+// EventMouseMoved to a Locked dispatcher with one listener, then calls
+// process_events. Reports heap allocations per event, which should be 0
+// once the queue's vectors have grown.
+//
+// Args: [events per frame, default 1000] [frames, default 4000]
+
+#include <EverEngineCore/Event.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "Bench.hpp"
+
+namespace EverEngineBench
+{
+    namespace
+    {
+        using namespace EverEngine;
+
+        constexpr int Repeats = 3;
+    }
+
+    int run_event_queue(int argc, char** argv)
+    {
+        const int eventsPerFrame = argc > 0 ? std::atoi(argv[0]) : 1000;
+        const int frames = argc > 1 ? std::atoi(argv[1]) : 4000;
+        if (eventsPerFrame <= 0 || frames <= 0)
+        {
+            std::printf("event-queue: events per frame and frames must be positive\n");
+            return 1;
+        }
+
+        EventDispatcher dispatcher;
+        double sum = 0.0;
+        dispatcher.add_event_listener<EventMouseMoved>([&](EventMouseMoved& event) { sum += event.x; });
+
+        auto post_frame = [&]()
+        {
+            for (int i = 0; i < eventsPerFrame; ++i)
+            {
+                dispatcher.post_event(EventMouseMoved(static_cast<double>(i), 1.0));
+            }
+            dispatcher.process_events();
+        };
+
+        // Grows the queue to its peak size before timing.
+        post_frame();
+
+        std::printf("%d events per frame, %d frames\n", eventsPerFrame, frames);
+        const double events = static_cast<double>(eventsPerFrame) * frames;
+        for (int repeat = 0; repeat < Repeats; ++repeat)
+        {
+            const size_t allocationsBefore = get_allocation_count();
+            const Clock::time_point start = Clock::now();
+            for (int frame = 0; frame < frames; ++frame)
+            {
+                post_frame();
+            }
+            const double seconds = seconds_since(start);
+
+            std::printf("%7.2f M events/s  %.2f allocations per event\n",
+                events / seconds / 1e6, (get_allocation_count() - allocationsBefore) / events);
+        }
+        return sum < 0.0;
+    }
+}
@@ -0,0 +1,160 @@
+// P producers post EventMouseMoved while one consumer drains with
+// process_events, in both queue modes. A second pass measures posting alone,
+// into a queue large enough to hold every event.
+//
+// Args: [total events, default 4000000]
+
+#include <EverEngineCore/Event.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "Bench.hpp"
+
+namespace EverEngineBench
+{
+    namespace
+    {
+        using namespace EverEngine;
+
+        constexpr int Repeats = 3;
+        constexpr size_t QueueCapacity = 4096;
+        constexpr long PostOnlyEvents = 1 << 20;
+
+        const char* get_mode_name(EventQueueMode mode)
+        {
+            return mode == EventQueueMode::LockFree ? "LockFree" : "Locked";
+        }
+
+        void run_end_to_end(EventQueueMode mode, int producerCount, long total)
+        {
+            EventDispatcher dispatcher(mode, QueueCapacity);
+            const long perProducer = total / producerCount;
+            const long expected = perProducer * producerCount;
+
+            long received = 0;
+            dispatcher.add_event_listener<EventMouseMoved>([&](EventMouseMoved&) { ++received; });
+
+            std::atomic<int> finished = 0;
+            std::atomic<long> fullRetries = 0;
+            const Clock::time_point start = Clock::now();
+
+            std::vector<std::thread> producers;
+            for (int p = 0; p < producerCount; ++p)
+            {
+                producers.emplace_back([&, p]()
+                {
+                    long retries = 0;
+                    for (long s = 0; s < perProducer; ++s)
+                    {
+                        while (!dispatcher.post_event(EventMouseMoved(static_cast<double>(p), static_cast<double>(s))))
+                        {
+                            ++retries;
+                            std::this_thread::yield();
+                        }
+                    }
+                    fullRetries += retries;
+                    ++finished;
+                });
+            }
+
+            while (finished.load() < producerCount || received < expected)
+            {
+                const long before = received;
+                dispatcher.process_events();
+                if (received == before)
+                {
+                    // A spinning consumer keeps producers blocked on a full
+                    // ring for a whole timeslice when threads outnumber cores.
+                    std::this_thread::yield();
+                }
+            }
+            const double seconds = seconds_since(start);
+            for (std::thread& producer : producers)
+            {
+                producer.join();
+            }
+
+            std::printf("%-8s producers=%2d: %7.2f M events/s  full-ring retries=%ld\n",
+                get_mode_name(mode), producerCount, expected / seconds / 1e6, fullRetries.load());
+        }
+
+        void run_post_only(EventQueueMode mode, int producerCount)
+        {
+            EventDispatcher dispatcher(mode, PostOnlyEvents);
+            long received = 0;
+            dispatcher.add_event_listener<EventMouseMoved>([&](EventMouseMoved&) { ++received; });
+
+            // Warm up so the Locked queue's vectors are already at capacity.
+            dispatcher.post_event(EventMouseMoved(0.0, 0.0));
+            dispatcher.process_events();
+            received = 0;
+
+            const long perProducer = PostOnlyEvents / producerCount;
+            std::atomic<long> failed = 0;
+            const Clock::time_point start = Clock::now();
+
+            std::vector<std::thread> producers;
+            for (int p = 0; p < producerCount; ++p)
+            {
+                producers.emplace_back([&, p]()
+                {
+                    long failures = 0;
+                    for (long s = 0; s < perProducer; ++s)
+                    {
+                        failures += !dispatcher.post_event(EventMouseMoved(static_cast<double>(p), static_cast<double>(s)));
+                    }
+                    failed += failures;
+                });
+            }
+            for (std::thread& producer : producers)
+            {
+                producer.join();
+            }
+            const double seconds = seconds_since(start);
+            dispatcher.process_events();
+
+            std::printf("%-8s producers=%2d: %7.2f M posts/s   delivered=%ld failed=%ld\n",
+                get_mode_name(mode), producerCount, perProducer * producerCount / seconds / 1e6,
+                received, failed.load());
+        }
+    }
+
+    int run_event_queue_mpsc(int argc, char** argv)
+    {
+        const long total = argc > 0 ? std::atol(argv[0]) : 4000000;
+        if (total <= 0)
+        {
+            std::printf("event-queue-mpsc: total events must be positive\n");
+            return 1;
+        }
+
+        std::printf("Post and dispatch, %ld events, queue capacity %zu\n", total, QueueCapacity);
+        for (int repeat = 0; repeat < Repeats; ++repeat)
+        {
+            for (EventQueueMode mode : { EventQueueMode::Locked, EventQueueMode::LockFree })
+            {
+                for (int producerCount : { 1, 4, 16 })
+                {
+                    run_end_to_end(mode, producerCount, total);
+                }
+            }
+        }
+
+        std::printf("Post only, %ld events\n", PostOnlyEvents);
+        for (int repeat = 0; repeat < Repeats; ++repeat)
+        {
+            for (EventQueueMode mode : { EventQueueMode::Locked, EventQueueMode::LockFree })
+            {
+                for (int producerCount : { 1, 4, 16 })
+                {
+                    run_post_only(mode, producerCount);
+                }
+            }
+        }
+        return 0;
+    }
+}
@@ -0,0 +1,94 @@
+// JobSystem::parallel_for scaling against a serial loop over 1M items of
+// arithmetic work, and its per-job overhead with 65536 one-item chunks.
+// The calling thread runs jobs too, so threads = workers + 1.
+//
+// Args: [worker counts..., default: auto 1 2 3 7 15]
+
+#include <EverEngineCore/JobSystem.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "Bench.hpp"
+
+namespace EverEngineBench
+{
+    namespace
+    {
+        using namespace EverEngine;
+
+        constexpr int Repeats = 5;
+        constexpr size_t ItemCount = 1 << 20;
+        constexpr size_t TinyJobCount = 65536;
+
+        // Best of Repeats, in milliseconds.
+        template<typename FuncT>
+        double get_best_ms(FuncT&& func)
+        {
+            double best = 1e30;
+            for (int repeat = 0; repeat < Repeats; ++repeat)
+            {
+                const Clock::time_point start = Clock::now();
+                func();
+                best = std::min(best, seconds_since(start) * 1e3);
+            }
+            return best;
+        }
+    }
+
+    int run_parallel_for(int argc, char** argv)
+    {
+        std::vector<uint32_t> workerCounts;
+        for (int i = 0; i < argc; ++i)
+        {
+            workerCounts.push_back(static_cast<uint32_t>(std::strtoul(argv[i], nullptr, 10)));
+        }
+        if (workerCounts.empty())
+        {
+            workerCounts = { 0, 1, 2, 3, 7, 15 };
+        }
+
+        std::vector<float> out(ItemCount);
+        auto work = [&](size_t i)
+        {
+            float x = static_cast<float>(i);
+            for (int k = 0; k < 32; ++k)
+            {
+                x = std::sqrt(x * 1.0001f + 1.0f);
+            }
+            out[i] = x;
+        };
+
+        const double serialMs = get_best_ms([&]()
+        {
+            for (size_t i = 0; i < ItemCount; ++i)
+            {
+                work(i);
+            }
+        });
+        std::printf("serial loop: %.2f ms\n", serialMs);
+
+        for (uint32_t workerCount : workerCounts)
+        {
+            JobSystem jobSystem({ workerCount, false });
+            const uint32_t threads = jobSystem.get_worker_count() + 1;
+
+            const double parallelMs = get_best_ms([&]() { jobSystem.parallel_for(0, ItemCount, 0, work); });
+            const double tinyMs = get_best_ms([&]()
+            {
+                jobSystem.parallel_for(0, TinyJobCount, 1, [&](size_t i) { out[i] += 1.0f; });
+            });
+
+            std::printf("threads=%2u%s: parallel_for %.2f ms (%.2fx serial), %.0f ns per one-item job\n",
+                threads, workerCount == 0 ? " (auto)" : "", parallelMs, serialMs / parallelMs,
+                tinyMs * 1e6 / TinyJobCount);
+        }
+
+        volatile float sink = out[123];
+        (void)sink;
+        return 0;
+    }
+}
@@ -0,0 +1,236 @@
+// RenderQueue with 50k draws spread at random over 8 programs, 16 VAOs and
+// 32 textures, executed in submission order (all keys 0) and sorted. Reports
+// the state changes left and the time of each step, then the radix sort
+// against std::stable_sort on the bare keys.
+//
+// Needs a GL context: opens a hidden GLFW window and draws into a small
+// offscreen framebuffer.
+//
+// Args: [draw count, default 50000]
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include "Rendering/OpenGL/RendererOpenGL.hpp"
+#include "Rendering/OpenGL/RenderQueue.hpp"
+#include "Rendering/OpenGL/StateCache.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Bench.hpp"
+
+namespace EverEngineBench
+{
+    namespace
+    {
+        using namespace EverEngine;
+
+        constexpr int Repeats = 3;
+        constexpr int SortRepeats = 10;
+        constexpr int ProgramCount = 8;
+        constexpr int VertexArrayCount = 16;
+        constexpr int TextureCount = 32;
+        constexpr GLsizei TargetSize = 8;
+
+        GLuint compile_program(int variant)
+        {
+            const char* vertexSource =
+                "#version 330 core\n"
+                "layout(location = 0) in vec2 position;\n"
+                "void main() { gl_Position = vec4(position * 0.01, 0.0, 1.0); }\n";
+            // Each variant is a distinct program the driver cannot share.
+            const std::string fragmentSource =
+                "#version 330 core\n"
+                "uniform sampler2D tex;\n"
+                "out vec4 color;\n"
+                "void main() { color = texture(tex, vec2(0.0)) * " + std::to_string(variant + 1) + ".0; }\n";
+            const char* fragmentCString = fragmentSource.c_str();
+
+            const GLuint program = glCreateProgram();
+            for (auto [type, pSource] : { std::pair<GLenum, const char*>{ GL_VERTEX_SHADER, vertexSource },
+                                          std::pair<GLenum, const char*>{ GL_FRAGMENT_SHADER, fragmentCString } })
+            {
+                const GLuint shader = glCreateShader(type);
+                glShaderSource(shader, 1, &pSource, nullptr);
+                glCompileShader(shader);
+                glAttachShader(program, shader);
+                glDeleteShader(shader);
+            }
+            glLinkProgram(program);
+            return program;
+        }
+
+        double get_ms_since(Clock::time_point start)
+        {
+            return seconds_since(start) * 1e3;
+        }
+    }
+
+    int run_render_queue(int argc, char** argv)
+    {
+        const int drawCount = argc > 0 ? std::atoi(argv[0]) : 50000;
+        if (drawCount <= 0)
+        {
+            std::printf("render-queue: draw count must be positive\n");
+            return 1;
+        }
+
+        if (!glfwInit())
+        {
+            std::printf("render-queue: glfwInit failed\n");
+            return 1;
+        }
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        GLFWwindow* pWindow = glfwCreateWindow(64, 64, "EverEngineBench", nullptr, nullptr);
+        if (!pWindow)
+        {
+            std::printf("render-queue: no GL context\n");
+            glfwTerminate();
+            return 1;
+        }
+        glfwMakeContextCurrent(pWindow);
+        if (!Renderer_OpenGL::init(pWindow))
+        {
+            glfwDestroyWindow(pWindow);
+            glfwTerminate();
+            return 1;
+        }
+        std::printf("%s | %s\n", Renderer_OpenGL::get_version_str(), Renderer_OpenGL::get_renderer_str());
+
+        GLuint framebuffer = 0;
+        GLuint target = 0;
+        glGenFramebuffers(1, &framebuffer);
+        glGenTextures(1, &target);
+        glBindTexture(GL_TEXTURE_2D, target);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, TargetSize, TargetSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target, 0);
+        glViewport(0, 0, TargetSize, TargetSize);
+
+        std::vector<GLuint> programs;
+        for (int i = 0; i < ProgramCount; ++i)
+        {
+            programs.push_back(compile_program(i));
+        }
+
+        const float triangle[] = { 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f };
+        std::vector<GLuint> vertexArrays(VertexArrayCount);
+        std::vector<GLuint> buffers(VertexArrayCount);
+        glGenVertexArrays(VertexArrayCount, vertexArrays.data());
+        glGenBuffers(VertexArrayCount, buffers.data());
+        for (int i = 0; i < VertexArrayCount; ++i)
+        {
+            glBindVertexArray(vertexArrays[i]);
+            glBindBuffer(GL_ARRAY_BUFFER, buffers[i]);
+            glBufferData(GL_ARRAY_BUFFER, sizeof(triangle), triangle, GL_STATIC_DRAW);
+            glEnableVertexAttribArray(0);
+            glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+        }
+
+        std::vector<GLuint> textures(TextureCount);
+        glGenTextures(TextureCount, textures.data());
+        const uint32_t white = 0xffffffff;
+        for (GLuint texture : textures)
+        {
+            glBindTexture(GL_TEXTURE_2D, texture);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, &white);
+        }
+        // The setup above bound objects behind the cache's back.
+        StateCache::invalidate();
+
+        std::mt19937 rng(1);
+        std::vector<RenderCommand> commands(drawCount);
+        for (RenderCommand& command : commands)
+        {
+            command = {};
+            command.program = programs[rng() % ProgramCount];
+            command.vao = vertexArrays[rng() % VertexArrayCount];
+            command.texture = textures[rng() % TextureCount];
+            command.mode = GL_TRIANGLES;
+            command.count = 3;
+            command.instanceCount = 1;
+            command.sortKey = RenderQueue::make_sort_key(0, command.program, command.texture, (rng() % 1000) / 1000.0f);
+        }
+
+        RenderQueue queue;
+        std::printf("%d draws\n", drawCount);
+        for (int repeat = 0; repeat < Repeats; ++repeat)
+        {
+            for (bool bSorted : { false, true })
+            {
+                const Clock::time_point submitStart = Clock::now();
+                for (RenderCommand command : commands)
+                {
+                    // The radix sort is stable, so zero keys keep submission order.
+                    if (!bSorted)
+                    {
+                        command.sortKey = 0;
+                    }
+                    queue.submit(command);
+                }
+                const double submitMs = get_ms_since(submitStart);
+
+                const Clock::time_point sortStart = Clock::now();
+                queue.sort();
+                const double sortMs = get_ms_since(sortStart);
+
+                const Clock::time_point executeStart = Clock::now();
+                queue.execute();
+                glFinish();
+                const double executeMs = get_ms_since(executeStart);
+
+                const RenderQueueStats& stats = queue.get_stats();
+                std::printf("%s: submit %6.2f ms, sort %6.2f ms, execute %8.2f ms | %u program, %u vao, %u texture changes\n",
+                    bSorted ? "sorted          " : "submission order", submitMs, sortMs, executeMs,
+                    stats.programChanges, stats.vertexArrayChanges, stats.textureChanges);
+                queue.clear();
+            }
+        }
+
+        std::vector<uint64_t> keys;
+        keys.reserve(commands.size());
+        for (const RenderCommand& command : commands)
+        {
+            keys.push_back(command.sortKey);
+            queue.submit(command);
+        }
+
+        const Clock::time_point stableSortStart = Clock::now();
+        for (int repeat = 0; repeat < SortRepeats; ++repeat)
+        {
+            std::vector<uint64_t> sorted = keys;
+            std::stable_sort(sorted.begin(), sorted.end());
+        }
+        const double stableSortMs = get_ms_since(stableSortStart) / SortRepeats;
+
+        const Clock::time_point radixSortStart = Clock::now();
+        for (int repeat = 0; repeat < SortRepeats; ++repeat)
+        {
+            queue.sort();
+        }
+        const double radixSortMs = get_ms_since(radixSortStart) / SortRepeats;
+        queue.clear();
+
+        std::printf("radix sort %.2f ms, std::stable_sort on the keys %.2f ms\n", radixSortMs, stableSortMs);
+
+        glDeleteTextures(TextureCount, textures.data());
+        glDeleteBuffers(VertexArrayCount, buffers.data());
+        glDeleteVertexArrays(VertexArrayCount, vertexArrays.data());
+        for (GLuint program : programs)
+        {
+            glDeleteProgram(program);
+        }
+        glDeleteTextures(1, &target);
+        glDeleteFramebuffers(1, &framebuffer);
+        Renderer_OpenGL::shutdown();
+
+        glfwDestroyWindow(pWindow);
+        glfwTerminate();
+        return 0;
+    }
+}
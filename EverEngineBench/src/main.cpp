@@ -0,0 +1,56 @@
+#include <cstdio>
+#include <cstring>
+
+#include "Bench.hpp"
+
+namespace
+{
+    struct Benchmark
+    {
+        const char* name;
+        const char* description;
+        int (*run)(int argc, char** argv);
+    };
+
+    const Benchmark s_benchmarks[] = {
+        { "delegate", "Delegate versus std::function listener calls, dispatch cost",
+            EverEngineBench::run_delegate },
+        { "event-queue", "EventDispatcher post and dispatch throughput, allocations per event",
+            EverEngineBench::run_event_queue },
+        { "event-queue-mpsc", "EventDispatcher throughput with concurrent producers, both queue modes",
+            EverEngineBench::run_event_queue_mpsc },
+        { "parallel-for", "JobSystem::parallel_for scaling and per-job overhead",
+            EverEngineBench::run_parallel_for },
+        { "render-queue", "RenderQueue state changes and sort cost over 50k draws (needs a GL context)",
+            EverEngineBench::run_render_queue },
+    };
+
+    void print_usage()
+    {
+        std::printf("Usage: EverEngineBench <benchmark> [args]\n");
+        for (const Benchmark& benchmark : s_benchmarks)
+        {
+            std::printf("  %-20s %s\n", benchmark.name, benchmark.description);
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        print_usage();
+        return 1;
+    }
+
+    for (const Benchmark& benchmark : s_benchmarks)
+    {
+        if (std::strcmp(argv[1], benchmark.name) == 0)
+        {
+            return benchmark.run(argc - 2, argv + 2);
+        }
+    }
+
+    print_usage();
+    return 1;
+}
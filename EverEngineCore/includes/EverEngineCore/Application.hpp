@@ -2,11 +2,30 @@
 #define APPLICATION_HPP
 
 #include "EverEngineCore/Event.hpp"
+#include "EverEngineCore/JobSystem.hpp"
 
 #include <memory>
+#include <cstdint>
 
 namespace EverEngine 
 {
+    struct FrameStats
+    {
+        // Seconds between the start of the previous frame and this one.
+        double frameTime = 0.0;
+        // Seconds of work in the last frame, excluding the frame cap wait.
+        double cpuTime = 0.0;
+
+        // Refreshed once per second.
+        double averageFrameTime = 0.0;
+        double minFrameTime = 0.0;
+        double maxFrameTime = 0.0;
+        double fps = 0.0;
+
+        uint64_t frameCount = 0;
+        uint32_t fixedSteps = 0;
+    };
+
     class Application
     {
     private:
@@ -22,16 +41,56 @@ namespace EverEngine
 
         virtual int start(unsigned window_width, unsigned int window_height, const char* title);
 
+        // Called zero or more times per frame with a constant step.
+        virtual void on_fixed_update([[maybe_unused]] double fixedDeltaTime) {};
+        // Called once per frame after the fixed steps and before the frame
+        // is rendered; blend simulation state with get_interpolation_alpha().
         virtual void on_update() {};
+
+        void set_fixed_timestep(double seconds);
+        // 0 disables the cap.
+        void set_frame_rate_limit(unsigned int fps);
+        void set_max_fixed_steps(unsigned int steps);
+        // Watches assets/ and recompiles shaders when their files change.
+        // On by default in debug builds; takes effect in start(). While on,
+        // assets.pak is not mounted when the loose assets/ directory exists.
+        void set_hot_reload(bool bEnabled) { m_bHotReload = bEnabled; }
+
+        double get_fixed_timestep() const { return m_fixedTimestep; }
+        double get_delta_time() const { return m_frameStats.frameTime; }
+        double get_interpolation_alpha() const { return m_interpolationAlpha; }
+        const FrameStats& get_frame_stats() const { return m_frameStats; }
+
+        JobSystem& get_job_system() { return *m_pJobSystem; }
     
     private:
+        void update_frame_stats(double frameTime, double cpuTime);
+
         std::unique_ptr<class Window> m_pWindow;
         std::unique_ptr<class Renderer> m_Renderer;
 
+        std::unique_ptr<JobSystem> m_pJobSystem;
+
         EventDispatcher m_event_dispatcher;
         bool m_bCloseWindow = false;
+#ifdef NDEBUG
+        bool m_bHotReload = false;
+#else
+        bool m_bHotReload = true;
+#endif
+
+        double m_fixedTimestep = 1.0 / 60.0;
+        double m_targetFrameTime = 0.0;
+        unsigned int m_maxFixedSteps = 8;
+        double m_interpolationAlpha = 0.0;
+
+        FrameStats m_frameStats;
+        double m_statsElapsed = 0.0;
+        double m_statsMin = 0.0;
+        double m_statsMax = 0.0;
+        uint32_t m_statsFrames = 0;
     };
 
 }
 
-#endif // !APPLICATION_HPP
\ No newline at end of file
+#endif // !APPLICATION_HPP
@@ -0,0 +1,136 @@
+#ifndef DELEGATE_HPP
+#define DELEGATE_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace EverEngine
+{
+    template<typename Signature, size_t Capacity = 32>
+    class Delegate;
+
+    // Move-only type-erased callable with inline storage. Unlike std::function
+    // it never allocates: callables larger than Capacity are rejected at
+    // compile time. Calling through it costs a single indirect call, and
+    // trivially copyable callables (plain lambdas capturing pointers or
+    // references) are moved with a memcpy.
+    template<typename R, typename... Args, size_t Capacity>
+    class Delegate<R(Args...), Capacity>
+    {
+    public:
+        Delegate() = default;
+        Delegate(std::nullptr_t) {}
+
+        template<typename F>
+            requires (!std::is_same_v<std::decay_t<F>, Delegate>) &&
+                     std::is_invocable_r_v<R, std::decay_t<F>&, Args...>
+        Delegate(F&& func)
+        {
+            using Fn = std::decay_t<F>;
+            static_assert(sizeof(Fn) <= Capacity,
+                "Delegate: callable is larger than the inline buffer, capture less or raise Capacity");
+            static_assert(alignof(Fn) <= alignof(std::max_align_t),
+                "Delegate: callable is over-aligned");
+            static_assert(std::is_nothrow_move_constructible_v<Fn>,
+                "Delegate: callable must be nothrow move constructible");
+
+            ::new (static_cast<void*>(m_storage)) Fn(std::forward<F>(func));
+            m_invoke = &invoke<Fn>;
+            if constexpr (!std::is_trivially_copyable_v<Fn>)
+            {
+                m_manage = &manage<Fn>;
+            }
+        }
+
+        ~Delegate() { reset(); }
+
+        Delegate(const Delegate&) = delete;
+        Delegate& operator=(const Delegate&) = delete;
+
+        Delegate(Delegate&& other) noexcept
+        {
+            move_from(other);
+        }
+
+        Delegate& operator=(Delegate&& other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                move_from(other);
+            }
+            return *this;
+        }
+
+        Delegate& operator=(std::nullptr_t)
+        {
+            reset();
+            return *this;
+        }
+
+        R operator()(Args... args) const
+        {
+            return m_invoke(m_storage, std::forward<Args>(args)...);
+        }
+
+        explicit operator bool() const { return m_invoke != nullptr; }
+
+        void reset()
+        {
+            if (m_manage)
+            {
+                m_manage(Operation::Destroy, m_storage, nullptr);
+            }
+            m_invoke = nullptr;
+            m_manage = nullptr;
+        }
+
+    private:
+        enum class Operation { Move, Destroy };
+
+        template<typename Fn>
+        static R invoke(void* storage, Args&&... args)
+        {
+            return (*static_cast<Fn*>(storage))(std::forward<Args>(args)...);
+        }
+
+        template<typename Fn>
+        static void manage(Operation op, void* dst, void* src)
+        {
+            if (op == Operation::Move)
+            {
+                ::new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+                static_cast<Fn*>(src)->~Fn();
+            }
+            else
+            {
+                static_cast<Fn*>(dst)->~Fn();
+            }
+        }
+
+        void move_from(Delegate& other) noexcept
+        {
+            if (other.m_manage)
+            {
+                other.m_manage(Operation::Move, m_storage, other.m_storage);
+            }
+            else if (other.m_invoke)
+            {
+                std::memcpy(m_storage, other.m_storage, Capacity);
+            }
+            m_invoke = other.m_invoke;
+            m_manage = other.m_manage;
+            other.m_invoke = nullptr;
+            other.m_manage = nullptr;
+        }
+
+        alignas(std::max_align_t) mutable unsigned char m_storage[Capacity];
+        R (*m_invoke)(void*, Args&&...) = nullptr;
+        void (*m_manage)(Operation, void*, void*) = nullptr;
+    };
+}
+
+#endif // !DELEGATE_HPP
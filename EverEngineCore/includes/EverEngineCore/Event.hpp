@@ -1,12 +1,18 @@
 #ifndef EVENT_HPP
 #define EVENT_HPP
 
-#include <functional>
 #include <vector>
 #include <array>
-#include <queue>
+#include <variant>
 #include <mutex>
 #include <memory>
+#include <type_traits>
+#include <algorithm>
+#include <cstdint>
+
+#include "EverEngineCore/Delegate.hpp"
+#include "EverEngineCore/MPSCQueue.hpp"
+#include "EverEngineCore/Profiler.hpp"
 
 namespace EverEngine
 {
@@ -23,102 +29,440 @@ namespace EverEngine
         MouseWheelScroll,
         MouseMoved,
 
+        AsyncReadCompleted,
+        FileChanged,
+
         EventCount,
     };
 
-    struct BaseEvent
+    // Events are plain value types: no vtable, no heap. The static `type`
+    // selects the listener list at compile time.
+    struct BaseEvent {};
+
+    struct EventWindowClose : public BaseEvent
+    {
+        static constexpr EventType type = EventType::WindowClose;
+    };
+
+    struct EventMouseMoved : public BaseEvent
     {
-        virtual ~BaseEvent() = default;
-        virtual EventType get_type() const = 0;
+        static constexpr EventType type = EventType::MouseMoved;
+
+        double x;
+        double y;
+
+        EventMouseMoved(double nx, double ny)
+            : x(nx), y(ny) {}
+    };
+
+    struct EventWindowResize : public BaseEvent
+    {
+        static constexpr EventType type = EventType::WindowResize;
+
+        unsigned int width;
+        unsigned int height;
+
+        EventWindowResize(unsigned int w, unsigned int h)
+            : width(w), height(h) {}
+    };
+
+    struct EventMouseWheelScroll : public BaseEvent
+    {
+        static constexpr EventType type = EventType::MouseWheelScroll;
+
+        double xOffset;
+        double yOffset;
+
+        EventMouseWheelScroll(double dx, double dy)
+            : xOffset(dx), yOffset(dy) {}
+
+        void accumulate(const EventMouseWheelScroll& older)
+        {
+            xOffset += older.xOffset;
+            yOffset += older.yOffset;
+        }
+    };
+
+    // Posted from an I/O worker; the main thread hands the id back to
+    // FileSystem::AsyncFile::DeliverCompletion to run the request's callbacks.
+    struct EventAsyncReadCompleted : public BaseEvent
+    {
+        static constexpr EventType type = EventType::AsyncReadCompleted;
+
+        uint64_t requestId;
+
+        explicit EventAsyncReadCompleted(uint64_t id)
+            : requestId(id) {}
+    };
+
+    enum class FileChangeAction : uint8_t
+    {
+        Created,
+        Modified,
+        Removed,
+    };
+
+    // Posted by the asset file watcher after a batch of changes settles.
+    // path is interned by the watcher and stays valid after it stops.
+    struct EventFileChanged : public BaseEvent
+    {
+        static constexpr EventType type = EventType::FileChanged;
+
+        const char* path;
+        FileChangeAction action;
+
+        EventFileChanged(const char* changedPath, FileChangeAction changeAction)
+            : path(changedPath), action(changeAction) {}
+    };
+
+    // Events carrying relative values can be merged by CoalescePolicy::AccumulateDelta.
+    template<typename EventT>
+    concept AccumulatableEvent = requires(EventT& newer, const EventT& older)
+    {
+        newer.accumulate(older);
+    };
+
+    // Tagged storage for any concrete event, so the queue holds events by value.
+    // std::monostate is the empty state of a default-constructed slot.
+    using Event = std::variant<
+        std::monostate,
+        EventWindowResize,
+        EventWindowClose,
+        EventMouseMoved,
+        EventMouseWheelScroll,
+        EventAsyncReadCompleted,
+        EventFileChanged
+    >;
+
+    inline EventType get_event_type(const Event& event)
+    {
+        return std::visit([](const auto& e)
+        {
+            using EventT = std::decay_t<decltype(e)>;
+            if constexpr (std::is_same_v<EventT, std::monostate>)
+            {
+                return EventType::EventCount;
+            }
+            else
+            {
+                return EventT::type;
+            }
+        }, event);
+    }
+
+    enum class EventQueueMode
+    {
+        // Mutex-guarded queue, unbounded.
+        Locked = 0,
+        // Bounded lock-free MPSC ring; post_event fails when it is full.
+        LockFree,
+    };
+
+    enum class CoalescePolicy
+    {
+        // Deliver every event (default).
+        KeepAll = 0,
+        // Deliver only the last event of the type posted this frame.
+        KeepLatest,
+        // Merge all events of the type into the last one through
+        // EventT::accumulate; behaves as KeepLatest for other events.
+        AccumulateDelta,
+    };
+
+    // Returned by add_event_listener, pass to remove_event_listener.
+    struct ListenerHandle
+    {
+        EventType type = EventType::EventCount;
+        uint32_t id = 0;
+
+        bool is_valid() const { return id != 0; }
     };
 
     class EventDispatcher
     {
     public:
-        template<typename EventT>
-        void add_event_listener(std::function<void(EventT&)> callback)
+        explicit EventDispatcher(EventQueueMode mode = EventQueueMode::Locked,
+            size_t queueCapacity = 256)
+            : m_mode(mode)
+        {
+            if (m_mode == EventQueueMode::LockFree)
+            {
+                m_lockFreeQueue = std::make_unique<MPSCQueue<Event>>(queueCapacity);
+                queueCapacity = m_lockFreeQueue->capacity();
+            }
+            else
+            {
+                m_queue.reserve(queueCapacity);
+            }
+            m_processing.reserve(queueCapacity);
+        }
+
+        EventQueueMode get_queue_mode() const { return m_mode; }
+
+        // Coalescing happens once per process_events, on the frame's batch,
+        // before any listener runs. A surviving event keeps the position of
+        // the last one it replaced.
+        void set_coalesce_policy(EventType type, CoalescePolicy policy)
+        {
+            m_coalescePolicies[static_cast<size_t>(type)] = policy;
+
+            m_bCoalescing = false;
+            for (CoalescePolicy p : m_coalescePolicies)
+            {
+                m_bCoalescing |= (p != CoalescePolicy::KeepAll);
+            }
+        }
+
+        CoalescePolicy get_coalesce_policy(EventType type) const
+        {
+            return m_coalescePolicies[static_cast<size_t>(type)];
+        }
+
+        // Listeners run in descending priority order, equal priorities in
+        // registration order. The callback is stored inline in a Delegate,
+        // so registering does not allocate per listener.
+        template<typename EventT, typename CallbackT>
+        ListenerHandle add_event_listener(CallbackT&& callback, int priority = 0)
         {
             const size_t index = static_cast<size_t>(EventT::type);
 
-            auto baseCallback = [func = std::move(callback)](BaseEvent& e)
+            Listener listener;
+            listener.callback = [func = std::forward<CallbackT>(callback)](BaseEvent& e) mutable
             {
                 func(static_cast<EventT&>(e));
             };
+            listener.priority = priority;
+            listener.id = m_nextListenerId++;
+
+            const ListenerHandle handle { EventT::type, listener.id };
+
+            if (m_dispatchDepth > 0)
+            {
+                m_pendingListeners.push_back({ index, std::move(listener) });
+            }
+            else
+            {
+                insert_listener(index, std::move(listener));
+            }
 
-            m_eventCallbacks[index].push_back(std::move(baseCallback));
+            return handle;
         }
 
-        void post_event(std::unique_ptr<BaseEvent> event)
+        // Safe to call from inside a listener, including for itself.
+        void remove_event_listener(ListenerHandle& handle)
         {
+            if (!handle.is_valid())
+            {
+                return;
+            }
+
+            auto& listeners = m_listeners[static_cast<size_t>(handle.type)];
+            for (auto& listener : listeners)
+            {
+                if (listener.id == handle.id)
+                {
+                    // Only marked here: the delegate may be the one running,
+                    // so it is destroyed by flush_listener_changes once no
+                    // dispatch is in progress.
+                    listener.id = 0;
+                    m_bListenersDirty = true;
+                    break;
+                }
+            }
+
+            for (auto& [index, listener] : m_pendingListeners)
+            {
+                if (listener.id == handle.id)
+                {
+                    listener.id = 0;
+                }
+            }
+
+            handle = {};
+            if (m_dispatchDepth == 0)
+            {
+                flush_listener_changes();
+            }
+        }
+
+        // Thread-safe. Only fails in LockFree mode when the ring is full.
+        bool post_event(const Event& event)
+        {
+            if (m_lockFreeQueue)
+            {
+                return m_lockFreeQueue->try_push(event);
+            }
+
             std::lock_guard<std::mutex> lock(m_queueMutex);
-            m_queue.push(std::move(event));
+            m_queue.push_back(event);
+            return true;
         }
 
+        // Both queues keep their capacity between frames, so once they have
+        // grown to the peak per-frame event count nothing is allocated.
+        // Must be called from a single consumer thread.
         void process_events()
         {
-            std::queue<std::unique_ptr<BaseEvent>> localQueue;
+            PROFILE_SCOPE("EventDispatcher::process_events");
 
+            if (m_lockFreeQueue)
+            {
+                // Bounded by the ring size so producers that keep posting
+                // cannot starve the rest of the frame.
+                Event event;
+                const size_t limit = m_lockFreeQueue->capacity();
+                while (m_processing.size() < limit && m_lockFreeQueue->try_pop(event))
+                {
+                    m_processing.push_back(event);
+                }
+            }
+            else
             {
                 std::lock_guard<std::mutex> lock(m_queueMutex);
-                std::swap(localQueue, m_queue);
+                std::swap(m_queue, m_processing);
             }
-            
-            while (!localQueue.empty())
+
+            if (m_bCoalescing)
+            {
+                coalesce();
+            }
+
+            for (auto& event : m_processing)
             {
-                auto& event = *localQueue.front();
                 dispatch(event);
-                localQueue.pop();
             }
+            m_processing.clear();
         }
 
-        void dispatch(BaseEvent& event)
+        void dispatch(Event& event)
         {
-            const size_t index = static_cast<size_t>(event.get_type());
+            std::visit([this](auto& e) { dispatch(e); }, event);
+        }
 
-            for (auto& callback : m_eventCallbacks[index])
+        void dispatch(std::monostate&) {}
+
+        template<typename EventT>
+        void dispatch(EventT& event)
+        {
+            const auto& listeners = m_listeners[static_cast<size_t>(EventT::type)];
+
+            ++m_dispatchDepth;
+            for (const auto& listener : listeners)
+            {
+                if (listener.id != 0)
+                {
+                    listener.callback(event);
+                }
+            }
+            --m_dispatchDepth;
+
+            if (m_dispatchDepth == 0)
             {
-                callback(event);
+                flush_listener_changes();
             }
         }
 
     private:
-        std::array<std::vector<std::function<void(BaseEvent&)>>,
-                static_cast<size_t>(EventType::EventCount)> m_eventCallbacks {};
-        std::queue<std::unique_ptr<BaseEvent>> m_queue;
-        std::mutex m_queueMutex;
-    };
+        struct Listener
+        {
+            Delegate<void(BaseEvent&), 48> callback;
+            int priority = 0;
+            uint32_t id = 0;
+        };
 
-    struct EventWindowClose : public BaseEvent
-    {
-        static inline const EventType type = EventType::WindowClose;
+        struct PendingListener
+        {
+            size_t index;
+            Listener listener;
+        };
 
-        EventType get_type() const override { return type; }
-    };
+        void insert_listener(size_t index, Listener&& listener)
+        {
+            auto& listeners = m_listeners[index];
+            auto it = std::upper_bound(listeners.begin(), listeners.end(), listener.priority,
+                [](int priority, const Listener& other) { return priority > other.priority; });
+            listeners.insert(it, std::move(listener));
+        }
 
-    struct EventMouseMoved : public BaseEvent
-    {
-        static inline const EventType type = EventType::MouseMoved;
+        // Listener lists are only mutated outside of dispatch, so a listener
+        // adding or removing listeners never invalidates the loop running it.
+        void flush_listener_changes()
+        {
+            if (m_bListenersDirty)
+            {
+                for (auto& listeners : m_listeners)
+                {
+                    std::erase_if(listeners, [](const Listener& l) { return l.id == 0; });
+                }
+                m_bListenersDirty = false;
+            }
 
-        double x;
-        double y;
+            if (!m_pendingListeners.empty())
+            {
+                for (auto& [index, listener] : m_pendingListeners)
+                {
+                    if (listener.id != 0)
+                    {
+                        insert_listener(index, std::move(listener));
+                    }
+                }
+                m_pendingListeners.clear();
+            }
+        }
 
-        EventMouseMoved(double nx, double ny)
-            : x(nx), y(ny) {}
+        // Replaces superseded events with std::monostate in place, so the
+        // batch is never reallocated or reordered.
+        void coalesce()
+        {
+            constexpr size_t none = static_cast<size_t>(-1);
+            std::array<size_t, static_cast<size_t>(EventType::EventCount)> latest;
+            latest.fill(none);
 
-        EventType get_type() const override { return type; }
-    };
+            for (size_t i = 0; i < m_processing.size(); ++i)
+            {
+                Event& event = m_processing[i];
+                const size_t index = static_cast<size_t>(get_event_type(event));
+                if (index == static_cast<size_t>(EventType::EventCount) ||
+                    m_coalescePolicies[index] == CoalescePolicy::KeepAll)
+                {
+                    continue;
+                }
 
-    struct EventWindowResize : public BaseEvent
-    {
-        static inline const EventType type = EventType::WindowResize;
+                size_t& previous = latest[index];
+                if (previous != none)
+                {
+                    if (m_coalescePolicies[index] == CoalescePolicy::AccumulateDelta)
+                    {
+                        std::visit([&](auto& newer)
+                        {
+                            using EventT = std::decay_t<decltype(newer)>;
+                            if constexpr (AccumulatableEvent<EventT>)
+                            {
+                                newer.accumulate(std::get<EventT>(m_processing[previous]));
+                            }
+                        }, event);
+                    }
+                    m_processing[previous] = std::monostate{};
+                }
+                previous = i;
+            }
+        }
 
-        unsigned int width;
-        unsigned int height;
+        std::array<std::vector<Listener>,
+                static_cast<size_t>(EventType::EventCount)> m_listeners {};
+        std::vector<PendingListener> m_pendingListeners;
+        uint32_t m_nextListenerId = 1;
+        uint32_t m_dispatchDepth = 0;
+        bool m_bListenersDirty = false;
 
-        EventWindowResize(unsigned int w, unsigned int h)
-            : width(w), height(h) {}
+        std::array<CoalescePolicy, static_cast<size_t>(EventType::EventCount)> m_coalescePolicies {};
+        bool m_bCoalescing = false;
 
-        EventType get_type() const override { return type; }
+        EventQueueMode m_mode;
+        std::vector<Event> m_queue;
+        std::vector<Event> m_processing;
+        std::mutex m_queueMutex;
+        std::unique_ptr<MPSCQueue<Event>> m_lockFreeQueue;
     };
 }
 
@@ -0,0 +1,135 @@
+#ifndef JOB_SYSTEM_HPP
+#define JOB_SYSTEM_HPP
+
+#include "EverEngineCore/Delegate.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace EverEngine
+{
+    using JobFunction = Delegate<void(), 48>;
+
+    struct JobSystemDesc
+    {
+        // Background worker threads. 0 picks one per physical core the
+        // process may run on (its affinity mask), minus the thread that owns
+        // the JobSystem.
+        uint32_t workerCount = 0;
+        // Pin each worker to its own logical core within the affinity mask.
+        bool pinThreads = true;
+    };
+
+    // Counts unfinished jobs. Jobs scheduled with run_after() are held by the
+    // counter they depend on and released when it reaches zero.
+    class JobCounter
+    {
+    public:
+        JobCounter() = default;
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        bool is_done() const { return m_count.load(std::memory_order_acquire) == 0; }
+
+    private:
+        friend class JobSystem;
+
+        struct Continuation
+        {
+            JobFunction function;
+            JobCounter* counter;
+        };
+
+        std::atomic<uint32_t> m_count { 0 };
+        std::mutex m_mutex;
+        std::vector<Continuation> m_continuations;
+    };
+
+    // Work-stealing scheduler: every thread owns a deque, pops its own work
+    // LIFO and steals FIFO from the others when it runs dry.
+    class JobSystem
+    {
+    public:
+        explicit JobSystem(const JobSystemDesc& desc = {});
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        uint32_t get_worker_count() const { return static_cast<uint32_t>(m_workers.size()); }
+
+        void run(JobFunction job, JobCounter* counter = nullptr);
+        void run_after(JobCounter& dependency, JobFunction job, JobCounter* counter = nullptr);
+
+        // Executes pending jobs on the calling thread until the counter is
+        // done. Use this rather than polling is_done() before destroying a
+        // counter that jobs may still be finishing.
+        void wait(JobCounter& counter);
+
+        // Calls func(i) for every i in [begin, end), split in chunks of
+        // grainSize (0 picks a size giving a few chunks per thread).
+        template<typename FuncT>
+        void parallel_for(size_t begin, size_t end, size_t grainSize, FuncT&& func)
+        {
+            if (begin >= end)
+            {
+                return;
+            }
+
+            const size_t count = end - begin;
+            if (grainSize == 0)
+            {
+                const size_t chunks = (get_worker_count() + 1) * 4;
+                grainSize = (count + chunks - 1) / chunks;
+            }
+
+            JobCounter counter;
+            auto* pFunc = &func;
+            for (size_t chunkBegin = begin; chunkBegin < end; chunkBegin += grainSize)
+            {
+                const size_t chunkEnd = chunkBegin + grainSize < end ? chunkBegin + grainSize : end;
+                run([pFunc, chunkBegin, chunkEnd]()
+                {
+                    for (size_t i = chunkBegin; i < chunkEnd; ++i)
+                    {
+                        (*pFunc)(i);
+                    }
+                }, &counter);
+            }
+            wait(counter);
+        }
+
+    private:
+        struct Job
+        {
+            JobFunction function;
+            JobCounter* counter = nullptr;
+        };
+
+        struct alignas(64) WorkerQueue;
+
+        void worker_main(uint32_t index);
+        void push(Job&& job);
+        bool try_pop(Job& job);
+        void execute(Job& job);
+        void finish(JobCounter& counter);
+        uint32_t get_queue_index() const;
+
+        std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+        std::vector<std::thread> m_workers;
+
+        std::atomic<uint32_t> m_pendingJobs { 0 };
+        std::atomic<uint32_t> m_sleepingWorkers { 0 };
+        std::atomic<bool> m_bStop { false };
+        std::mutex m_sleepMutex;
+        std::condition_variable m_wakeCondition;
+    };
+}
+
+#endif // !JOB_SYSTEM_HPP
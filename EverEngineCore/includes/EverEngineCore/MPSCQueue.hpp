@@ -0,0 +1,106 @@
+#ifndef MPSC_QUEUE_HPP
+#define MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace EverEngine
+{
+    // Bounded lock-free multi-producer / single-consumer ring buffer.
+    // Every slot carries a sequence number telling producers and the consumer
+    // whose turn it is, so pushes only contend on a single fetch position and
+    // never block each other. Capacity is rounded up to a power of two.
+    template<typename T>
+    class MPSCQueue
+    {
+    public:
+        explicit MPSCQueue(size_t capacity)
+        {
+            size_t size = 2;
+            while (size < capacity)
+            {
+                size <<= 1;
+            }
+
+            m_mask = size - 1;
+            m_slots = std::make_unique<Slot[]>(size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                m_slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        MPSCQueue(const MPSCQueue&) = delete;
+        MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+        size_t capacity() const { return m_mask + 1; }
+
+        // Safe to call from any thread. Returns false when the ring is full.
+        bool try_push(const T& value)
+        {
+            size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+            Slot* slot = nullptr;
+
+            for (;;)
+            {
+                slot = &m_slots[pos & m_mask];
+                const size_t seq = slot->sequence.load(std::memory_order_acquire);
+                const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+                if (diff == 0)
+                {
+                    if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = m_enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+
+            slot->value = value;
+            slot->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer thread only. Returns false when no published element is ready.
+        bool try_pop(T& out)
+        {
+            Slot& slot = m_slots[m_dequeuePos & m_mask];
+            const size_t seq = slot.sequence.load(std::memory_order_acquire);
+
+            if (seq != m_dequeuePos + 1)
+            {
+                return false;
+            }
+
+            out = std::move(slot.value);
+            slot.sequence.store(m_dequeuePos + m_mask + 1, std::memory_order_release);
+            ++m_dequeuePos;
+            return true;
+        }
+
+    private:
+        struct Slot
+        {
+            std::atomic<size_t> sequence;
+            T value;
+        };
+
+        std::unique_ptr<Slot[]> m_slots;
+        size_t m_mask = 0;
+
+        alignas(64) std::atomic<size_t> m_enqueuePos { 0 };
+        alignas(64) size_t m_dequeuePos = 0;
+    };
+}
+
+#endif // !MPSC_QUEUE_HPP
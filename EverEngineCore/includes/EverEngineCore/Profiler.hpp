@@ -0,0 +1,85 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <cstdint>
+#include <string>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+// Scopes are compiled in for debug builds, or for any build configured
+// with EVERENGINE_ENABLE_PROFILER.
+#if !defined(NDEBUG) || defined(EVERENGINE_ENABLE_PROFILER)
+#define EVERENGINE_PROFILER_ENABLED
+#endif
+
+namespace EverEngine
+{
+    class Profiler
+    {
+    public:
+        // Raw timestamp: TSC ticks on x86, steady_clock nanoseconds elsewhere.
+        static uint64_t now()
+        {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+#else
+            return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+        }
+
+        // Appends a sample to the calling thread's ring buffer. Only the
+        // most recent samples of each thread are kept.
+        static void record(const char* name, uint64_t start, uint64_t end);
+
+        static void set_thread_name(const char* name);
+
+        // Writes every buffered sample in the Chrome trace event format
+        // (chrome://tracing, Perfetto). Call while other threads are not
+        // recording, e.g. between frames or at shutdown.
+        static bool write_chrome_trace(const std::string& path);
+
+        static void clear();
+    };
+
+    class ProfileScope
+    {
+    public:
+        explicit ProfileScope(const char* name)
+            : m_name(name), m_start(Profiler::now()) {}
+
+        ~ProfileScope()
+        {
+            Profiler::record(m_name, m_start, Profiler::now());
+        }
+
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+    private:
+        const char* m_name;
+        uint64_t m_start;
+    };
+}
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef EVERENGINE_PROFILER_ENABLED
+
+#define PROFILE_SCOPE(name)     ::EverEngine::ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+#define PROFILE_FUNCTION()      PROFILE_SCOPE(__func__)
+
+#else
+
+#define PROFILE_SCOPE(name)
+#define PROFILE_FUNCTION()
+
+#endif
+
+#endif // !PROFILER_HPP
@@ -2,14 +2,29 @@
 #include "EverEngineCore/Log.hpp"
 #include "Window.hpp"
 #include "Rendering/OpenGL/RendererOpenGL.hpp"
+#include "Platform/Generic/FileSystem.hpp"
+#include "Platform/Generic/FileWatcher.hpp"
+#include "Rendering/OpenGL/Shader.hpp"
 #include "EverEngineCore/Event.hpp"
+#include "EverEngineCore/Profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
 
 namespace EverEngine
 {
+    static_assert(static_cast<int>(FileSystem::FileChangeType::Created) == static_cast<int>(FileChangeAction::Created) &&
+                  static_cast<int>(FileSystem::FileChangeType::Modified) == static_cast<int>(FileChangeAction::Modified) &&
+                  static_cast<int>(FileSystem::FileChangeType::Removed) == static_cast<int>(FileChangeAction::Removed),
+                  "FileChangeAction must mirror FileSystem::FileChangeType");
+
     Application::Application()
     {
         LOG_INFO("START::APPLICATION");
 
+        m_pJobSystem = std::make_unique<JobSystem>();
+
     }
 
     Application::~Application()
@@ -19,6 +34,19 @@ namespace EverEngine
 
     int Application::start(unsigned int window_width, unsigned int window_height, const char* title)
     {
+        // Packed assets built by EverEnginePacker take precedence over the
+        // loose assets/ directory when present. Hot reload watches the loose
+        // files, so the archive would hide every change it picks up; it is
+        // only mounted then when there are no loose assets.
+        const bool bWatchAssets = m_bHotReload && FileSystem::Directory::Exists("assets");
+        if (FileSystem::File::IsFile("assets.pak")) {
+            if (bWatchAssets) {
+                LOG_INFO("APPLICATION::HOT_RELOAD: assets.pak not mounted, using loose assets/");
+            } else {
+                FileSystem::VirtualFileSystem::Mount("assets.pak", "assets");
+            }
+        }
+
         m_pWindow = std::make_unique<Window>(title, window_width, window_height);
         m_Renderer = std::make_unique<Renderer>();
 
@@ -35,6 +63,12 @@ namespace EverEngine
                 LOG_INFO("EVENT::CHANGE::SIZE({0}x{1})", event.width, event.height);
             }
         );
+        m_event_dispatcher.add_event_listener<EventMouseWheelScroll>(
+            [](EventMouseWheelScroll& event)
+            {
+                LOG_INFO("EVENT::MOUSE::SCROLL({0}x{1})", event.xOffset, event.yOffset);
+            }
+        );
         m_event_dispatcher.add_event_listener<EventWindowClose>(
             [&](EventWindowClose& event){
                 LOG_INFO("[WINDOW_CLOSE]");
@@ -42,20 +76,173 @@ namespace EverEngine
             }
         );
 
+        m_event_dispatcher.add_event_listener<EventAsyncReadCompleted>(
+            [](EventAsyncReadCompleted& event)
+            {
+                FileSystem::AsyncFile::DeliverCompletion(event.requestId);
+            }
+        );
+
+        FileSystem::AsyncFile::SetMainThreadDispatch(
+            [&](uint64_t requestId){
+                return m_event_dispatcher.post_event(EventAsyncReadCompleted(requestId));
+            }
+        );
+
+        m_event_dispatcher.add_event_listener<EventFileChanged>(
+            [](EventFileChanged& event)
+            {
+                LOG_INFO("EVENT::FILE_CHANGED: {0}", event.path);
+                if (event.action != FileChangeAction::Removed)
+                {
+                    Shader::reload_dependents(event.path);
+                }
+            }
+        );
+
+        if (bWatchAssets)
+        {
+            FileSystem::FileWatcher::SetDispatch(
+                [&](const char* path, FileSystem::FileChangeType type){
+                    m_event_dispatcher.post_event(EventFileChanged(path, static_cast<FileChangeAction>(type)));
+                }
+            );
+            FileSystem::FileWatcher::Watch("assets");
+        }
+
+        m_event_dispatcher.set_coalesce_policy(EventType::MouseMoved, CoalescePolicy::KeepLatest);
+        m_event_dispatcher.set_coalesce_policy(EventType::WindowResize, CoalescePolicy::KeepLatest);
+        m_event_dispatcher.set_coalesce_policy(EventType::MouseWheelScroll, CoalescePolicy::AccumulateDelta);
+
         m_pWindow->set_event_callback(
-            [&](std::unique_ptr<BaseEvent> event){
-                m_event_dispatcher.post_event(std::move(event));
+            [&](const Event& event){
+                m_event_dispatcher.post_event(event);
             }
         );
 
+        using Clock = std::chrono::steady_clock;
+        using Seconds = std::chrono::duration<double>;
+
+        // Frame times above this are clamped so a debugger break or a
+        // window drag does not trigger a burst of catch-up steps.
+        constexpr double maxFrameTime = 0.25;
+        // The OS sleep is only trusted up to this margin, the rest is spun.
+        constexpr auto spinMargin = std::chrono::microseconds(1500);
+
+        double accumulator = 0.0;
+        Clock::time_point previousFrameStart = Clock::now();
+
+        Profiler::set_thread_name("Main");
+
         while (!m_bCloseWindow)
         {
-            m_pWindow->on_update();
+            PROFILE_SCOPE("Frame");
+
+            const Clock::time_point frameStart = Clock::now();
+            const double frameTime = Seconds(frameStart - previousFrameStart).count();
+            previousFrameStart = frameStart;
+
+            accumulator += std::min(frameTime, maxFrameTime);
+
+            // Input first, so this frame's steps and render see it.
+            m_pWindow->poll_events();
             m_event_dispatcher.process_events();
-            on_update();
+
+            uint32_t steps = 0;
+            while (accumulator >= m_fixedTimestep && steps < m_maxFixedSteps)
+            {
+                PROFILE_SCOPE("Application::on_fixed_update");
+                on_fixed_update(m_fixedTimestep);
+                accumulator -= m_fixedTimestep;
+                ++steps;
+            }
+            if (steps == m_maxFixedSteps)
+            {
+                // Simulation cannot keep up, drop the backlog instead of spiralling.
+                accumulator = std::min(accumulator, m_fixedTimestep);
+            }
+
+            m_frameStats.fixedSteps = steps;
+            m_interpolationAlpha = accumulator / m_fixedTimestep;
+
+            {
+                PROFILE_SCOPE("Application::on_update");
+                on_update();
+            }
+
+            m_pWindow->on_update();
+
+            update_frame_stats(frameTime, Seconds(Clock::now() - frameStart).count());
+
+            if (m_targetFrameTime > 0.0)
+            {
+                PROFILE_SCOPE("Application::frame_wait");
+
+                const auto frameEnd = frameStart +
+                    std::chrono::duration_cast<Clock::duration>(Seconds(m_targetFrameTime));
+
+                if (frameEnd - Clock::now() > spinMargin)
+                {
+                    std::this_thread::sleep_until(frameEnd - spinMargin);
+                }
+                while (Clock::now() < frameEnd)
+                {
+                    std::this_thread::yield();
+                }
+            }
         }
+        FileSystem::AsyncFile::SetMainThreadDispatch(nullptr);
+        FileSystem::FileWatcher::SetDispatch(nullptr);
+        FileSystem::FileWatcher::Stop();
+        FileSystem::VirtualFileSystem::Unmount("assets.pak");
         m_pWindow = nullptr;
 
         return 0;
     }
+
+    void Application::set_fixed_timestep(double seconds)
+    {
+        if (seconds > 0.0)
+        {
+            m_fixedTimestep = seconds;
+        }
+    }
+
+    void Application::set_frame_rate_limit(unsigned int fps)
+    {
+        m_targetFrameTime = fps > 0 ? 1.0 / static_cast<double>(fps) : 0.0;
+    }
+
+    void Application::set_max_fixed_steps(unsigned int steps)
+    {
+        m_maxFixedSteps = std::max(steps, 1u);
+    }
+
+    void Application::update_frame_stats(double frameTime, double cpuTime)
+    {
+        m_frameStats.frameTime = frameTime;
+        m_frameStats.cpuTime = cpuTime;
+        ++m_frameStats.frameCount;
+
+        if (m_statsFrames == 0)
+        {
+            m_statsMin = frameTime;
+            m_statsMax = frameTime;
+        }
+        m_statsMin = std::min(m_statsMin, frameTime);
+        m_statsMax = std::max(m_statsMax, frameTime);
+        m_statsElapsed += frameTime;
+        ++m_statsFrames;
+
+        if (m_statsElapsed >= 1.0)
+        {
+            m_frameStats.averageFrameTime = m_statsElapsed / m_statsFrames;
+            m_frameStats.minFrameTime = m_statsMin;
+            m_frameStats.maxFrameTime = m_statsMax;
+            m_frameStats.fps = m_statsFrames / m_statsElapsed;
+
+            m_statsElapsed = 0.0;
+            m_statsFrames = 0;
+        }
+    }
 }
\ No newline at end of file
@@ -0,0 +1,330 @@
+#include "EverEngineCore/JobSystem.hpp"
+#include "EverEngineCore/Log.hpp"
+#include "EverEngineCore/Profiler.hpp"
+#include "Runtime/HAL/CPUinfo.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace EverEngine
+{
+    struct alignas(64) JobSystem::WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    namespace
+    {
+        struct ThreadContext
+        {
+            const JobSystem* owner = nullptr;
+            uint32_t index = 0;
+        };
+
+        thread_local ThreadContext t_context;
+
+        // Logical cores the process may run on. The affinity mask also
+        // reflects a cgroup cpuset, so in a container limited to 4 CPUs this
+        // is those 4, not every core of the host.
+        std::vector<uint32_t> get_usable_cores(uint32_t logicalCores)
+        {
+            std::vector<uint32_t> cores;
+#if defined(_WIN32)
+            DWORD_PTR processMask = 0;
+            DWORD_PTR systemMask = 0;
+            if (GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask))
+            {
+                for (uint32_t core = 0; core < sizeof(DWORD_PTR) * 8; ++core)
+                {
+                    if (processMask & (DWORD_PTR(1) << core))
+                    {
+                        cores.push_back(core);
+                    }
+                }
+            }
+#elif defined(__linux__)
+            cpu_set_t cpuset;
+            CPU_ZERO(&cpuset);
+            if (sched_getaffinity(0, sizeof(cpuset), &cpuset) == 0)
+            {
+                for (uint32_t core = 0; core < CPU_SETSIZE; ++core)
+                {
+                    if (CPU_ISSET(core, &cpuset))
+                    {
+                        cores.push_back(core);
+                    }
+                }
+            }
+#endif
+            if (cores.empty())
+            {
+                for (uint32_t core = 0; core < logicalCores; ++core)
+                {
+                    cores.push_back(core);
+                }
+            }
+            return cores;
+        }
+
+        bool pin_thread(std::thread& thread, uint32_t logicalCore)
+        {
+#if defined(_WIN32)
+            return SetThreadAffinityMask(thread.native_handle(), DWORD_PTR(1) << logicalCore) != 0;
+#elif defined(__linux__)
+            cpu_set_t cpuset;
+            CPU_ZERO(&cpuset);
+            CPU_SET(logicalCore, &cpuset);
+            return pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpuset) == 0;
+#else
+            (void)thread;
+            (void)logicalCore;
+            return false;
+#endif
+        }
+    }
+
+    JobSystem::JobSystem(const JobSystemDesc& desc)
+    {
+        const CPUInfo cpu = CPUInfo::Detect();
+        const uint32_t logicalCores = std::max(cpu.logicalCores, 1u);
+        const uint32_t physicalCores = std::max(cpu.physicalCores, 1u);
+
+        const std::vector<uint32_t> usableCores = get_usable_cores(logicalCores);
+        const uint32_t usableCount = static_cast<uint32_t>(usableCores.size());
+        // The mask lists logical cores; assume the host's SMT ratio.
+        const uint32_t usablePhysical = std::clamp(usableCount * physicalCores / logicalCores, 1u, usableCount);
+
+        uint32_t workerCount = desc.workerCount;
+        if (workerCount == 0)
+        {
+            workerCount = std::max(usablePhysical, 2u) - 1;
+        }
+
+        // Queue 0 belongs to the owning thread and to any other thread that
+        // submits work without being a worker.
+        m_queues.reserve(workerCount + 1);
+        for (uint32_t i = 0; i < workerCount + 1; ++i)
+        {
+            m_queues.push_back(std::make_unique<WorkerQueue>());
+        }
+
+        t_context = { this, 0 };
+
+        m_workers.reserve(workerCount);
+        bool bPinFailed = false;
+        for (uint32_t i = 1; i <= workerCount; ++i)
+        {
+            m_workers.emplace_back(&JobSystem::worker_main, this, i);
+
+            // Logical cores are usually enumerated one per physical core
+            // first, so this spreads workers before doubling up on SMT siblings.
+            if (desc.pinThreads && workerCount < usableCount && !bPinFailed)
+            {
+                bPinFailed = !pin_thread(m_workers.back(), usableCores[i % usableCount]);
+            }
+        }
+        if (bPinFailed)
+        {
+            LOG_WARN("WARNING::JOB_SYSTEM::PIN_FAILED, remaining workers left unpinned");
+        }
+
+        LOG_INFO("JOB_SYSTEM::INIT: {0} workers ({1} physical / {2} logical cores, {3} usable)",
+            workerCount, physicalCores, logicalCores, usableCount);
+    }
+
+    JobSystem::~JobSystem()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+            m_bStop.store(true);
+        }
+        m_wakeCondition.notify_all();
+
+        for (auto& worker : m_workers)
+        {
+            worker.join();
+        }
+
+        if (t_context.owner == this)
+        {
+            t_context = {};
+        }
+    }
+
+    void JobSystem::run(JobFunction job, JobCounter* counter)
+    {
+        if (counter)
+        {
+            counter->m_count.fetch_add(1, std::memory_order_relaxed);
+        }
+        push({ std::move(job), counter });
+    }
+
+    void JobSystem::run_after(JobCounter& dependency, JobFunction job, JobCounter* counter)
+    {
+        if (counter)
+        {
+            counter->m_count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(dependency.m_mutex);
+            if (!dependency.is_done())
+            {
+                dependency.m_continuations.push_back({ std::move(job), counter });
+                return;
+            }
+        }
+
+        push({ std::move(job), counter });
+    }
+
+    void JobSystem::wait(JobCounter& counter)
+    {
+        Job job;
+        while (!counter.is_done())
+        {
+            if (try_pop(job))
+            {
+                execute(job);
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        // The last finish() may still hold the counter's lock; once we get
+        // it the caller is free to destroy the counter.
+        std::lock_guard<std::mutex> lock(counter.m_mutex);
+    }
+
+    void JobSystem::worker_main(uint32_t index)
+    {
+        t_context = { this, index };
+
+        const std::string name = "Worker " + std::to_string(index);
+        Profiler::set_thread_name(name.c_str());
+
+        Job job;
+        while (!m_bStop.load(std::memory_order_relaxed))
+        {
+            if (try_pop(job))
+            {
+                execute(job);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_sleepingWorkers.fetch_add(1);
+            m_wakeCondition.wait(lock, [this]()
+            {
+                return m_pendingJobs.load() > 0 || m_bStop.load();
+            });
+            m_sleepingWorkers.fetch_sub(1);
+        }
+    }
+
+    void JobSystem::push(Job&& job)
+    {
+        WorkerQueue& queue = *m_queues[get_queue_index()];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.jobs.push_back(std::move(job));
+        }
+
+        m_pendingJobs.fetch_add(1);
+        if (m_sleepingWorkers.load() > 0)
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+            m_wakeCondition.notify_one();
+        }
+    }
+
+    bool JobSystem::try_pop(Job& job)
+    {
+        if (m_pendingJobs.load(std::memory_order_relaxed) == 0)
+        {
+            return false;
+        }
+
+        const uint32_t self = get_queue_index();
+        {
+            WorkerQueue& queue = *m_queues[self];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.jobs.empty())
+            {
+                job = std::move(queue.jobs.back());
+                queue.jobs.pop_back();
+                m_pendingJobs.fetch_sub(1);
+                return true;
+            }
+        }
+
+        const uint32_t queueCount = static_cast<uint32_t>(m_queues.size());
+        for (uint32_t offset = 1; offset < queueCount; ++offset)
+        {
+            WorkerQueue& victim = *m_queues[(self + offset) % queueCount];
+            std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+            if (lock.owns_lock() && !victim.jobs.empty())
+            {
+                job = std::move(victim.jobs.front());
+                victim.jobs.pop_front();
+                m_pendingJobs.fetch_sub(1);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void JobSystem::execute(Job& job)
+    {
+        {
+            PROFILE_SCOPE("JobSystem::execute");
+            job.function();
+        }
+        job.function.reset();
+
+        if (job.counter)
+        {
+            finish(*job.counter);
+        }
+    }
+
+    void JobSystem::finish(JobCounter& counter)
+    {
+        std::vector<JobCounter::Continuation> released;
+        {
+            // Taking the lock before the decrement orders it against
+            // run_after() checking the counter.
+            std::lock_guard<std::mutex> lock(counter.m_mutex);
+            if (counter.m_count.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            {
+                return;
+            }
+            released.swap(counter.m_continuations);
+        }
+
+        for (auto& continuation : released)
+        {
+            push({ std::move(continuation.function), continuation.counter });
+        }
+    }
+
+    uint32_t JobSystem::get_queue_index() const
+    {
+        return t_context.owner == this ? t_context.index : 0;
+    }
+}
@@ -0,0 +1,176 @@
+#include "Compression.hpp"
+
+#include <cstring>
+#include <vector>
+#include <algorithm>
+
+namespace FileSystem
+{
+    namespace
+    {
+        constexpr size_t MinMatch = 4;
+        // The format requires the last 5 bytes to be literals and the last
+        // match to start at least 12 bytes before the end of the block.
+        constexpr size_t LastLiterals = 5;
+        constexpr size_t MatchFindLimit = 12;
+        constexpr size_t MaxOffset = 65535;
+        constexpr uint32_t HashBits = 14;
+
+        uint32_t Read32(const uint8_t* p)
+        {
+            uint32_t value;
+            std::memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        uint32_t Hash(uint32_t sequence)
+        {
+            return (sequence * 2654435761u) >> (32 - HashBits);
+        }
+
+        // Writes the 255-run length extension used for literal and match
+        // lengths of 15 and above.
+        bool WriteLength(uint8_t*& op, const uint8_t* opEnd, size_t length)
+        {
+            while (length >= 255) {
+                if (op >= opEnd) return false;
+                *op++ = 255;
+                length -= 255;
+            }
+            if (op >= opEnd) return false;
+            *op++ = static_cast<uint8_t>(length);
+            return true;
+        }
+
+        bool ReadLength(const uint8_t*& ip, const uint8_t* ipEnd, size_t& length)
+        {
+            uint8_t byte;
+            do {
+                if (ip >= ipEnd) return false;
+                byte = *ip++;
+                length += byte;
+            } while (byte == 255);
+            return true;
+        }
+
+        bool WriteSequence(uint8_t*& op, const uint8_t* opEnd,
+            const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength)
+        {
+            if (op >= opEnd) return false;
+            uint8_t* token = op++;
+
+            *token = static_cast<uint8_t>(std::min<size_t>(literalLength, 15) << 4);
+            if (literalLength >= 15 && !WriteLength(op, opEnd, literalLength - 15)) return false;
+
+            if (static_cast<size_t>(opEnd - op) < literalLength) return false;
+            std::memcpy(op, literals, literalLength);
+            op += literalLength;
+
+            // Last sequence: literals only.
+            if (matchLength == 0) return true;
+
+            if (opEnd - op < 2) return false;
+            *op++ = static_cast<uint8_t>(offset);
+            *op++ = static_cast<uint8_t>(offset >> 8);
+
+            const size_t extra = matchLength - MinMatch;
+            *token |= static_cast<uint8_t>(std::min<size_t>(extra, 15));
+            if (extra >= 15 && !WriteLength(op, opEnd, extra - 15)) return false;
+
+            return true;
+        }
+    }
+
+    size_t Compression::GetBound(size_t srcSize)
+    {
+        return srcSize + srcSize / 255 + 16;
+    }
+
+    size_t Compression::Compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity)
+    {
+        uint8_t* op = dst;
+        const uint8_t* opEnd = dst + dstCapacity;
+
+        size_t anchor = 0;
+        if (srcSize > MatchFindLimit) {
+            // Positions are stored +1 so 0 means "empty".
+            std::vector<uint32_t> table(size_t(1) << HashBits, 0);
+
+            const size_t matchLimit = srcSize - LastLiterals;
+            size_t ip = 0;
+
+            while (ip + MatchFindLimit < srcSize) {
+                const uint32_t sequence = Read32(src + ip);
+                const uint32_t h = Hash(sequence);
+                const size_t candidate = table[h];
+                table[h] = static_cast<uint32_t>(ip + 1);
+
+                if (candidate == 0 || ip - (candidate - 1) > MaxOffset ||
+                    Read32(src + candidate - 1) != sequence) {
+                    ++ip;
+                    continue;
+                }
+
+                const size_t ref = candidate - 1;
+                size_t length = MinMatch;
+                while (ip + length < matchLimit && src[ref + length] == src[ip + length]) {
+                    ++length;
+                }
+
+                if (!WriteSequence(op, opEnd, src + anchor, ip - anchor, ip - ref, length)) return 0;
+
+                ip += length;
+                anchor = ip;
+            }
+        }
+
+        if (!WriteSequence(op, opEnd, src + anchor, srcSize - anchor, 0, 0)) return 0;
+        return static_cast<size_t>(op - dst);
+    }
+
+    bool Compression::Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize)
+    {
+        const uint8_t* ip = src;
+        const uint8_t* ipEnd = src + srcSize;
+        uint8_t* op = dst;
+        uint8_t* opEnd = dst + dstSize;
+
+        while (ip < ipEnd) {
+            const uint8_t token = *ip++;
+
+            size_t literalLength = token >> 4;
+            if (literalLength == 15 && !ReadLength(ip, ipEnd, literalLength)) return false;
+            if (static_cast<size_t>(ipEnd - ip) < literalLength ||
+                static_cast<size_t>(opEnd - op) < literalLength) return false;
+
+            std::memcpy(op, ip, literalLength);
+            ip += literalLength;
+            op += literalLength;
+
+            if (ip == ipEnd) break;
+
+            if (ipEnd - ip < 2) return false;
+            const size_t offset = ip[0] | (size_t(ip[1]) << 8);
+            ip += 2;
+            if (offset == 0 || offset > static_cast<size_t>(op - dst)) return false;
+
+            size_t matchLength = token & 15;
+            if (matchLength == 15 && !ReadLength(ip, ipEnd, matchLength)) return false;
+            matchLength += MinMatch;
+            if (static_cast<size_t>(opEnd - op) < matchLength) return false;
+
+            const uint8_t* match = op - offset;
+            if (offset >= matchLength) {
+                std::memcpy(op, match, matchLength);
+                op += matchLength;
+            } else {
+                // Overlapping copy repeats the last offset bytes.
+                for (size_t i = 0; i < matchLength; ++i) {
+                    *op++ = *match++;
+                }
+            }
+        }
+
+        return op == opEnd;
+    }
+}
@@ -0,0 +1,26 @@
+#ifndef COMPRESSION_HPP
+#define COMPRESSION_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+namespace FileSystem
+{
+    // LZ4 block format codec. Self-contained so archives do not pull in a
+    // third-party dependency; output is readable by the reference LZ4
+    // decoder (LZ4_decompress_safe) and vice versa.
+    class Compression
+    {
+    public:
+        // Worst-case compressed size for srcSize bytes of input.
+        static size_t GetBound(size_t srcSize);
+
+        // Returns the compressed size, or 0 if dst is too small.
+        static size_t Compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity);
+
+        // Decodes exactly dstSize bytes. Returns false on malformed input.
+        static bool Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
+    };
+}
+
+#endif
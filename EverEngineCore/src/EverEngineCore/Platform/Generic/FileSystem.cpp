@@ -2,8 +2,20 @@
 #include <sstream>
 #include <cstring>
 #include <algorithm>
+#include <chrono>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <queue>
+#include <unordered_map>
+#include <optional>
+#include <shared_mutex>
 #include "FileSystem.hpp"
+#include "PakArchive.hpp"
+#include "EverEngineCore/Log.hpp"
+#include "EverEngineCore/Profiler.hpp"
+#include "EverEngineCore/JobSystem.hpp"
 
 #ifdef PLATFORM_WINDOWS
 #include <windows.h>
@@ -15,6 +27,16 @@
 #include <sys/stat.h>
 #include <dirent.h>
 #include <libgen.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#endif
+
+#if defined(__linux__)
+#include "../Linux/IoUring.hpp"
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/uio.h>
+#include <poll.h>
 #endif
 
 namespace FileSystem
@@ -90,66 +112,153 @@ namespace FileSystem
     #endif
     }
 
+    namespace
+    {
+        bool MatchGlobAt(std::string_view pattern, size_t p, std::string_view path, size_t s)
+        {
+            while (p < pattern.size()) {
+                const char c = pattern[p];
+                if (c == '*') {
+                    const bool bRecursive = p + 1 < pattern.size() && pattern[p + 1] == '*';
+                    p += bRecursive ? 2 : 1;
+
+                    if (bRecursive && p < pattern.size() && pattern[p] == '/') {
+                        // "**/" matches zero or more whole directories.
+                        if (MatchGlobAt(pattern, p + 1, path, s)) return true;
+                        for (size_t t = s; t < path.size(); ++t) {
+                            if (path[t] == '/' && MatchGlobAt(pattern, p + 1, path, t + 1)) return true;
+                        }
+                        return false;
+                    }
+
+                    for (size_t t = s; ; ++t) {
+                        if (MatchGlobAt(pattern, p, path, t)) return true;
+                        if (t == path.size()) return false;
+                        if (!bRecursive && path[t] == '/') return false;
+                    }
+                }
+
+                if (s == path.size()) return false;
+                if (c == '?' ? path[s] == '/' : path[s] != c) return false;
+                ++p;
+                ++s;
+            }
+            return s == path.size();
+        }
+    }
+
+    bool Path::MatchGlob(std::string_view pattern, std::string_view path)
+    {
+        return MatchGlobAt(pattern, 0, path, 0);
+    }
+
 
     // File
 
+    namespace
+    {
+        std::atomic<bool> s_bMetadataCacheEnabled{ false };
+        std::shared_mutex s_metadataMutex;
+        std::unordered_map<std::string, FileInfo> s_metadata;
+
+        FileInfo QueryFileInfo(const std::string& path)
+        {
+            FileInfo info;
+        #ifdef PLATFORM_WINDOWS
+            WIN32_FILE_ATTRIBUTE_DATA data;
+            if (!GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &data)) {
+                return info;
+            }
+            ULARGE_INTEGER size;
+            size.LowPart = data.nFileSizeLow;
+            size.HighPart = data.nFileSizeHigh;
+            ULARGE_INTEGER time;
+            time.LowPart = data.ftLastWriteTime.dwLowDateTime;
+            time.HighPart = data.ftLastWriteTime.dwHighDateTime;
+
+            info.exists = true;
+            info.isDirectory = (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+            info.size = info.isDirectory ? 0 : size.QuadPart;
+            info.lastModified = time.QuadPart;
+        #else
+            struct stat st;
+            if (stat(path.c_str(), &st) != 0) {
+                return info;
+            }
+            info.exists = true;
+            info.isDirectory = S_ISDIR(st.st_mode);
+            info.size = S_ISREG(st.st_mode) ? static_cast<uint64_t>(st.st_size) : 0;
+            info.lastModified = static_cast<uint64_t>(st.st_mtime);
+        #endif
+            return info;
+        }
+    }
+
+    FileInfo File::GetInfo(const std::string& path)
+    {
+        uint64_t archivedSize = 0;
+        if (VirtualFileSystem::GetSize(path, archivedSize)) {
+            FileInfo info;
+            info.exists = true;
+            info.isArchived = true;
+            info.size = archivedSize;
+            return info;
+        }
+
+        if (!s_bMetadataCacheEnabled.load(std::memory_order_relaxed)) {
+            return QueryFileInfo(path);
+        }
+
+        {
+            std::shared_lock<std::shared_mutex> lock(s_metadataMutex);
+            auto it = s_metadata.find(path);
+            if (it != s_metadata.end()) {
+                return it->second;
+            }
+        }
+
+        // Misses are cached too: probing for optional files is common at startup.
+        const FileInfo info = QueryFileInfo(path);
+        std::unique_lock<std::shared_mutex> lock(s_metadataMutex);
+        s_metadata.insert_or_assign(path, info);
+        return info;
+    }
+
     bool File::Exists(const std::string& path) 
     {
-        std::ifstream file(path);
-        return file.good();
+        return GetInfo(path).exists;
     }
 
     bool File::IsFile(const std::string& path) 
     {
-    #ifdef PLATFORM_WINDOWS
-        DWORD attr = GetFileAttributesA(path.c_str());
-        return (attr != INVALID_FILE_ATTRIBUTES && !(attr & FILE_ATTRIBUTE_DIRECTORY));
-    #else
-        struct stat st;
-        if (stat(path.c_str(), &st) != 0) return false;
-        return S_ISREG(st.st_mode);
-    #endif
+        const FileInfo info = GetInfo(path);
+        return info.exists && !info.isDirectory;
     }
 
     bool File::IsDirectory(const std::string& path) 
     {
-    #ifdef PLATFORM_WINDOWS
-        DWORD attr = GetFileAttributesA(path.c_str());
-        return (attr != INVALID_FILE_ATTRIBUTES && (attr & FILE_ATTRIBUTE_DIRECTORY));
-    #else
-        struct stat st;
-        if (stat(path.c_str(), &st) != 0) return false;
-        return S_ISDIR(st.st_mode);
-    #endif
+        return GetInfo(path).isDirectory;
     }
 
     uint64_t File::GetSize(const std::string& path) 
     {
-        std::ifstream file(path, std::ios::binary | std::ios::ate);
-        if (!file) return 0;
-        return static_cast<uint64_t>(file.tellg());
+        return GetInfo(path).size;
     }
 
     uint64_t File::GetLastModifiedTime(const std::string& path) 
     {
-    #ifdef PLATFORM_WINDOWS
-        WIN32_FILE_ATTRIBUTE_DATA data;
-        if (!GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &data)) {
-            return 0;
-        }
-        ULARGE_INTEGER ull;
-        ull.LowPart = data.ftLastWriteTime.dwLowDateTime;
-        ull.HighPart = data.ftLastWriteTime.dwHighDateTime;
-        return ull.QuadPart;
-    #else
-        struct stat st;
-        if (stat(path.c_str(), &st) != 0) return 0;
-        return static_cast<uint64_t>(st.st_mtime);
-    #endif
+        return GetInfo(path).lastModified;
     }
 
     std::vector<uint8_t> File::ReadBinary(const std::string& path) 
     {
+        PROFILE_SCOPE("File::ReadBinary");
+
+        std::vector<uint8_t> archived;
+        if (VirtualFileSystem::Read(path, archived)) {
+            return archived;
+        }
+
         std::ifstream file(path, std::ios::binary | std::ios::ate);
         if (!file) {
             return {};
@@ -166,25 +275,48 @@ namespace FileSystem
 
     std::string File::ReadText(const std::string& path) 
     {
-        std::ifstream file(path);
+        PROFILE_SCOPE("File::ReadText");
+
+        std::span<const std::byte> view = VirtualFileSystem::GetView(path);
+        if (!view.empty()) {
+            return std::string(reinterpret_cast<const char*>(view.data()), view.size());
+        }
+        std::vector<uint8_t> archived;
+        if (VirtualFileSystem::Read(path, archived)) {
+            return std::string(archived.begin(), archived.end());
+        }
+
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
         if (!file) {
             return "";
         }
-        
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        return buffer.str();
+
+        size_t size = file.tellg();
+        file.seekg(0, std::ios::beg);
+
+        std::string buffer(size, '\0');
+        file.read(buffer.data(), size);
+        return buffer;
     }
 
     std::vector<std::string> File::ReadLines(const std::string& path) 
     {
+        std::vector<std::string> lines;
+        std::string line;
+
+        if (VirtualFileSystem::Contains(path)) {
+            std::istringstream text(ReadText(path));
+            while (std::getline(text, line)) {
+                lines.push_back(line);
+            }
+            return lines;
+        }
+
         std::ifstream file(path);
         if (!file) {
             return {};
         }
         
-        std::vector<std::string> lines;
-        std::string line;
         while (std::getline(file, line)) {
             lines.push_back(line);
         }
@@ -192,8 +324,17 @@ namespace FileSystem
         return lines;
     }
 
+    MappedFile File::Map(const std::string& path, const MappedFileOptions& options)
+    {
+        MappedFile file;
+        file.Open(path, options);
+        return file;
+    }
+
     bool File::WriteBinary(const std::string& path, const void* data, size_t size) 
     {
+        MetadataCache::Invalidate(path);
+
         std::ofstream file(path, std::ios::binary);
         if (!file) return false;
         
@@ -203,6 +344,8 @@ namespace FileSystem
 
     bool File::WriteText(const std::string& path, const std::string& text) 
     {
+        MetadataCache::Invalidate(path);
+
         std::ofstream file(path);
         if (!file) return false;
         
@@ -212,6 +355,8 @@ namespace FileSystem
 
     bool File::AppendText(const std::string& path, const std::string& text) 
     {
+        MetadataCache::Invalidate(path);
+
         std::ofstream file(path, std::ios::app);
         if (!file) return false;
         
@@ -219,13 +364,168 @@ namespace FileSystem
         return file.good();
     }
 
+    // MAPPED FILE
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : m_pData(other.m_pData), m_size(other.m_size), m_bOpen(other.m_bOpen), m_hMapping(other.m_hMapping)
+    {
+        other.m_pData = nullptr;
+        other.m_size = 0;
+        other.m_bOpen = false;
+        other.m_hMapping = nullptr;
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other) {
+            Close();
+            std::swap(m_pData, other.m_pData);
+            std::swap(m_size, other.m_size);
+            std::swap(m_bOpen, other.m_bOpen);
+            std::swap(m_hMapping, other.m_hMapping);
+        }
+        return *this;
+    }
+
+    bool MappedFile::Open(const std::string& path, const MappedFileOptions& options)
+    {
+        PROFILE_SCOPE("MappedFile::Open");
+
+        Close();
+
+    #ifdef PLATFORM_WINDOWS
+        DWORD flags = FILE_ATTRIBUTE_NORMAL;
+        if (options.access == MapAccess::Sequential) flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+        else if (options.access == MapAccess::Random) flags |= FILE_FLAG_RANDOM_ACCESS;
+
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size)) {
+            CloseHandle(file);
+            return false;
+        }
+
+        m_size = static_cast<size_t>(size.QuadPart);
+        if (m_size > 0) {
+            HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping) {
+                m_pData = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            }
+            if (!m_pData) {
+                if (mapping) CloseHandle(mapping);
+                CloseHandle(file);
+                m_size = 0;
+                return false;
+            }
+            m_hMapping = mapping;
+        }
+        // The view keeps the file referenced on its own.
+        CloseHandle(file);
+    #else
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            close(fd);
+            return false;
+        }
+
+        m_size = static_cast<size_t>(st.st_size);
+        if (m_size > 0) {
+            void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                close(fd);
+                m_size = 0;
+                return false;
+            }
+            m_pData = data;
+        }
+        // The mapping keeps the file referenced on its own.
+        close(fd);
+
+    #if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if (options.hugePages && m_size > 0) {
+            madvise(const_cast<void*>(m_pData), m_size, MADV_HUGEPAGE);
+        }
+    #endif
+    #endif
+
+        m_bOpen = true;
+        if (options.access != MapAccess::Normal || options.prefetch) {
+            Advise(0, m_size, options.access, options.prefetch);
+        }
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_pData) {
+    #ifdef PLATFORM_WINDOWS
+            UnmapViewOfFile(m_pData);
+            CloseHandle(static_cast<HANDLE>(m_hMapping));
+    #else
+            munmap(const_cast<void*>(m_pData), m_size);
+    #endif
+        }
+        m_pData = nullptr;
+        m_size = 0;
+        m_bOpen = false;
+        m_hMapping = nullptr;
+    }
+
+    void MappedFile::Advise(size_t offset, size_t size, MapAccess access, bool prefetch) const
+    {
+        if (!m_pData || offset >= m_size) return;
+        size = std::min(size, m_size - offset);
+
+    #ifdef PLATFORM_WINDOWS
+        // Access patterns can only be set when the file is opened.
+        (void)access;
+        if (prefetch) {
+            WIN32_MEMORY_RANGE_ENTRY range;
+            range.VirtualAddress = const_cast<std::byte*>(static_cast<const std::byte*>(m_pData) + offset);
+            range.NumberOfBytes = size;
+            PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+        }
+    #else
+        // madvise needs a page-aligned start.
+        const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        const size_t alignedOffset = offset & ~(pageSize - 1);
+        void* start = const_cast<std::byte*>(static_cast<const std::byte*>(m_pData) + alignedOffset);
+        const size_t length = size + (offset - alignedOffset);
+
+        int advice = MADV_NORMAL;
+        if (access == MapAccess::Sequential) advice = MADV_SEQUENTIAL;
+        else if (access == MapAccess::Random) advice = MADV_RANDOM;
+        madvise(start, length, advice);
+
+        if (prefetch) {
+            madvise(start, length, MADV_WILLNEED);
+        }
+    #endif
+    }
+
     bool File::Delete(const std::string& path) 
     {
+        MetadataCache::Invalidate(path);
         return std::remove(path.c_str()) == 0;
     }
 
     bool File::Copy(const std::string& src, const std::string& dst) 
     {
+        MetadataCache::Invalidate(dst);
+
         std::ifstream srcFile(src, std::ios::binary);
         std::ofstream dstFile(dst, std::ios::binary);
         
@@ -237,6 +537,8 @@ namespace FileSystem
 
     bool File::Move(const std::string& src, const std::string& dst) 
     {
+        MetadataCache::Invalidate(src);
+        MetadataCache::Invalidate(dst);
         return std::rename(src.c_str(), dst.c_str()) == 0;
     }
 
@@ -246,10 +548,48 @@ namespace FileSystem
     }
 
 
+    // MetadataCache Implementation
+
+    void MetadataCache::SetEnabled(bool bEnabled)
+    {
+        s_bMetadataCacheEnabled.store(bEnabled);
+        if (!bEnabled) {
+            Refresh();
+        }
+    }
+
+    bool MetadataCache::IsEnabled()
+    {
+        return s_bMetadataCacheEnabled.load();
+    }
+
+    void MetadataCache::Invalidate(const std::string& path)
+    {
+        if (!s_bMetadataCacheEnabled.load(std::memory_order_relaxed)) return;
+
+        std::unique_lock<std::shared_mutex> lock(s_metadataMutex);
+        s_metadata.erase(path);
+    }
+
+    void MetadataCache::Refresh()
+    {
+        std::unique_lock<std::shared_mutex> lock(s_metadataMutex);
+        s_metadata.clear();
+    }
+
+    size_t MetadataCache::GetEntryCount()
+    {
+        std::shared_lock<std::shared_mutex> lock(s_metadataMutex);
+        return s_metadata.size();
+    }
+
+
     // Directory Implementation
 
     bool Directory::Create(const std::string& path) 
     {
+        MetadataCache::Invalidate(path);
+
     #ifdef PLATFORM_WINDOWS
         return _mkdir(path.c_str()) == 0;
     #else
@@ -285,6 +625,8 @@ namespace FileSystem
             }
         }
         
+        MetadataCache::Invalidate(path);
+
     #ifdef PLATFORM_WINDOWS
         return _rmdir(path.c_str()) == 0;
     #else
@@ -297,85 +639,246 @@ namespace FileSystem
         return File::IsDirectory(path);
     }
 
-    std::vector<std::string> Directory::ListFiles(const std::string& path) 
+    namespace
     {
-        std::vector<std::string> files;
-        
-    #ifdef PLATFORM_WINDOWS
-        WIN32_FIND_DATAA findData;
-        HANDLE hFind = FindFirstFileA((path + "\\*").c_str(), &findData);
-        
-        if (hFind != INVALID_HANDLE_VALUE) {
+        // Calls func(name, type, bSymlink) once per entry, without the "." and
+        // ".." entries. The type comes from the directory record itself and
+        // only falls back to a stat when the filesystem does not provide it.
+        template<typename Func>
+        bool ForEachEntry(const std::string& path, Func&& func)
+        {
+        #ifdef PLATFORM_WINDOWS
+            WIN32_FIND_DATAA findData;
+            HANDLE hFind = FindFirstFileExA((path + "\\*").c_str(), FindExInfoBasic, &findData,
+                FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
+            if (hFind == INVALID_HANDLE_VALUE) return false;
+
             do {
-                if (!(findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
-                    files.push_back(findData.cFileName);
+                if (strcmp(findData.cFileName, ".") == 0 || strcmp(findData.cFileName, "..") == 0) {
+                    continue;
                 }
+                const DWORD attr = findData.dwFileAttributes;
+                func(std::string_view(findData.cFileName),
+                    (attr & FILE_ATTRIBUTE_DIRECTORY) ? EntryType::Directory : EntryType::File,
+                    (attr & FILE_ATTRIBUTE_REPARSE_POINT) != 0);
             } while (FindNextFileA(hFind, &findData));
+
             FindClose(hFind);
-        }
-    #else
-        DIR* dir = opendir(path.c_str());
-        if (dir) {
+            return true;
+        #else
+            DIR* dir = opendir(path.c_str());
+            if (!dir) return false;
+            const int fd = dirfd(dir);
+
             struct dirent* entry;
             while ((entry = readdir(dir)) != nullptr) {
-                std::string fullPath = Path::Join(path, entry->d_name);
-                if (File::IsFile(fullPath)) {
-                    files.push_back(entry->d_name);
+                const char* name = entry->d_name;
+                if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+                    continue;
+                }
+
+                EntryType type = EntryType::Other;
+                bool bSymlink = false;
+                bool bNeedStat = true;
+            #ifdef _DIRENT_HAVE_D_TYPE
+                switch (entry->d_type) {
+                case DT_REG: type = EntryType::File; bNeedStat = false; break;
+                case DT_DIR: type = EntryType::Directory; bNeedStat = false; break;
+                case DT_LNK: bSymlink = true; break;
+                case DT_UNKNOWN: break;
+                default: bNeedStat = false; break;
+                }
+            #endif
+                if (bNeedStat) {
+                    // Follows links so they report their target's type.
+                    struct stat st;
+                    if (fstatat(fd, name, &st, 0) == 0) {
+                        if (S_ISREG(st.st_mode)) type = EntryType::File;
+                        else if (S_ISDIR(st.st_mode)) type = EntryType::Directory;
+                    }
+                    if (!bSymlink) {
+                        struct stat lst;
+                        bSymlink = fstatat(fd, name, &lst, AT_SYMLINK_NOFOLLOW) == 0 && S_ISLNK(lst.st_mode);
+                    }
                 }
+
+                func(std::string_view(name), type, bSymlink);
             }
+
             closedir(dir);
+            return true;
+        #endif
         }
-    #endif
-        
-        return files;
-    }
 
-    std::vector<std::string> Directory::ListDirectories(const std::string& path) 
-    {
-        std::vector<std::string> dirs;
-        
-    #ifdef PLATFORM_WINDOWS
-        WIN32_FIND_DATAA findData;
-        HANDLE hFind = FindFirstFileA((path + "\\*").c_str(), &findData);
-        
-        if (hFind != INVALID_HANDLE_VALUE) {
-            do {
-                if ((findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) &&
-                    strcmp(findData.cFileName, ".") != 0 &&
-                    strcmp(findData.cFileName, "..") != 0) {
-                    dirs.push_back(findData.cFileName);
+        std::vector<std::string> ListNames(const std::string& path, bool bFiles, bool bDirectories)
+        {
+            std::vector<std::string> names;
+            ForEachEntry(path, [&](std::string_view name, EntryType type, bool) {
+                if ((bFiles && type == EntryType::File) || (bDirectories && type == EntryType::Directory)) {
+                    names.emplace_back(name);
                 }
-            } while (FindNextFileA(hFind, &findData));
-            FindClose(hFind);
+            });
+            return names;
         }
-    #else
-        DIR* dir = opendir(path.c_str());
-        if (dir) {
-            struct dirent* entry;
-            while ((entry = readdir(dir)) != nullptr) {
-                if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
-                    continue;
+
+        struct ScanContext
+        {
+            std::string root;
+            const DirectoryScanOptions* options = nullptr;
+
+            std::mutex mutex;
+            std::vector<DirectoryListing> chunks;
+            EverEngine::JobCounter counter;
+        };
+
+        bool MatchesAny(const std::vector<std::string>& patterns, std::string_view path, std::string_view name)
+        {
+            for (const std::string& pattern : patterns) {
+                const bool bHasSlash = pattern.find('/') != std::string::npos;
+                if (Path::MatchGlob(pattern, bHasSlash ? path : name)) return true;
+            }
+            return false;
+        }
+
+        void ScanDirectory(ScanContext& context, const std::string& relativeDir)
+        {
+            const DirectoryScanOptions& options = *context.options;
+            const std::string diskPath = relativeDir.empty() ? context.root : Path::Join(context.root, relativeDir);
+
+            DirectoryListing chunk;
+            std::vector<std::string> subdirectories;
+            std::string entryPath;
+
+            ForEachEntry(diskPath, [&](std::string_view name, EntryType type, bool bSymlink) {
+                entryPath.assign(relativeDir);
+                if (!entryPath.empty()) entryPath += '/';
+                const size_t nameOffset = entryPath.size();
+                entryPath.append(name);
+
+                if (MatchesAny(options.exclude, entryPath, name)) return;
+
+                if (type == EntryType::Directory) {
+                    // Links are listed but not followed, so cycles cannot occur.
+                    if (options.recursive && !bSymlink) {
+                        subdirectories.push_back(entryPath);
+                    }
+                    if (!options.includeDirectories) return;
                 }
-                std::string fullPath = Path::Join(path, entry->d_name);
-                if (File::IsDirectory(fullPath)) {
-                    dirs.push_back(entry->d_name);
+
+                if (options.include.empty() || MatchesAny(options.include, entryPath, name)) {
+                    chunk.Add(entryPath, nameOffset, type);
+                }
+            });
+
+            if (!chunk.IsEmpty()) {
+                std::lock_guard<std::mutex> lock(context.mutex);
+                context.chunks.push_back(std::move(chunk));
+            }
+
+            for (std::string& subdirectory : subdirectories) {
+                if (options.jobSystem) {
+                    ScanContext* pContext = &context;
+                    options.jobSystem->run([pContext, subdirectory = std::move(subdirectory)]() {
+                        ScanDirectory(*pContext, subdirectory);
+                    }, &context.counter);
+                } else {
+                    ScanDirectory(context, subdirectory);
                 }
             }
-            closedir(dir);
         }
-    #endif
-        
-        return dirs;
+    }
+
+    std::vector<std::string> Directory::ListFiles(const std::string& path) 
+    {
+        return ListNames(path, true, false);
+    }
+
+    std::vector<std::string> Directory::ListDirectories(const std::string& path) 
+    {
+        return ListNames(path, false, true);
     }
 
     std::vector<std::string> Directory::ListAll(const std::string& path) 
     {
-        auto files = ListFiles(path);
-        auto dirs = ListDirectories(path);
-        files.insert(files.end(), dirs.begin(), dirs.end());
+        // Files first, then directories, as before.
+        std::vector<std::string> files;
+        std::vector<std::string> dirs;
+        ForEachEntry(path, [&](std::string_view name, EntryType type, bool) {
+            if (type == EntryType::File) files.emplace_back(name);
+            else if (type == EntryType::Directory) dirs.emplace_back(name);
+        });
+        files.insert(files.end(), std::make_move_iterator(dirs.begin()), std::make_move_iterator(dirs.end()));
         return files;
     }
 
+    bool Directory::Enumerate(const std::string& path, DirectoryListing& out)
+    {
+        return ForEachEntry(path, [&](std::string_view name, EntryType type, bool) {
+            out.Add(name, 0, type);
+        });
+    }
+
+    DirectoryListing Directory::Scan(const std::string& root, const DirectoryScanOptions& options)
+    {
+        PROFILE_SCOPE("Directory::Scan");
+
+        ScanContext context;
+        context.root = root;
+        context.options = &options;
+
+        ScanDirectory(context, "");
+        if (options.jobSystem) {
+            options.jobSystem->wait(context.counter);
+        }
+
+        DirectoryListing result;
+        for (const DirectoryListing& chunk : context.chunks) {
+            result.Append(chunk);
+        }
+        // Job scheduling makes chunk order nondeterministic.
+        result.SortByPath();
+        return result;
+    }
+
+    // DirectoryListing Implementation
+
+    void DirectoryListing::Add(std::string_view path, size_t nameOffset, EntryType type)
+    {
+        DirectoryEntry entry;
+        entry.pathOffset = static_cast<uint32_t>(m_strings.size());
+        entry.pathLength = static_cast<uint32_t>(path.size());
+        entry.nameOffset = static_cast<uint32_t>(nameOffset);
+        entry.type = type;
+
+        m_strings.insert(m_strings.end(), path.begin(), path.end());
+        m_entries.push_back(entry);
+    }
+
+    void DirectoryListing::Append(const DirectoryListing& other)
+    {
+        const uint32_t base = static_cast<uint32_t>(m_strings.size());
+        m_strings.insert(m_strings.end(), other.m_strings.begin(), other.m_strings.end());
+
+        m_entries.reserve(m_entries.size() + other.m_entries.size());
+        for (DirectoryEntry entry : other.m_entries) {
+            entry.pathOffset += base;
+            m_entries.push_back(entry);
+        }
+    }
+
+    void DirectoryListing::SortByPath()
+    {
+        std::sort(m_entries.begin(), m_entries.end(), [this](const DirectoryEntry& a, const DirectoryEntry& b) {
+            return GetPath(a) < GetPath(b);
+        });
+    }
+
+    void DirectoryListing::Clear()
+    {
+        m_entries.clear();
+        m_strings.clear();
+    }
+
     std::string Directory::GetCurrent() 
     {
         char buffer[1024];
@@ -425,26 +928,877 @@ namespace FileSystem
     }
 
 
+    // VirtualFileSystem Implementation
+
+    namespace
+    {
+        struct MountedArchive
+        {
+            std::string archivePath;
+            std::string mountPoint;
+            PakArchive archive;
+        };
+
+        std::shared_mutex s_mountMutex;
+        std::vector<std::unique_ptr<MountedArchive>> s_mounts;
+        // Lets lookups skip the lock entirely while nothing is mounted.
+        std::atomic<size_t> s_mountCount{ 0 };
+
+        // Calls func(archive, entry) for the newest mount that has the path.
+        // Runs under the shared lock, so func must not mount or unmount.
+        template<typename Func>
+        bool ResolveArchived(const std::string& path, Func&& func)
+        {
+            if (s_mountCount.load(std::memory_order_acquire) == 0) return false;
+
+            const std::string normalized = PakArchive::NormalizePath(path);
+
+            std::shared_lock<std::shared_mutex> lock(s_mountMutex);
+            for (auto it = s_mounts.rbegin(); it != s_mounts.rend(); ++it) {
+                const MountedArchive& mount = **it;
+
+                std::string_view relative = normalized;
+                if (!mount.mountPoint.empty()) {
+                    if (relative.size() <= mount.mountPoint.size() ||
+                        relative.compare(0, mount.mountPoint.size(), mount.mountPoint) != 0 ||
+                        relative[mount.mountPoint.size()] != '/') {
+                        continue;
+                    }
+                    relative.remove_prefix(mount.mountPoint.size() + 1);
+                }
+
+                if (const PakEntry* entry = mount.archive.Find(relative)) {
+                    func(mount.archive, *entry);
+                    return true;
+                }
+            }
+            return false;
+        }
+    }
+
+    bool VirtualFileSystem::Mount(const std::string& archivePath, const std::string& mountPoint)
+    {
+        auto mount = std::make_unique<MountedArchive>();
+        mount->archivePath = archivePath;
+        mount->mountPoint = PakArchive::NormalizePath(mountPoint);
+        while (!mount->mountPoint.empty() && mount->mountPoint.back() == '/') {
+            mount->mountPoint.pop_back();
+        }
+
+        if (!mount->archive.Open(archivePath)) {
+            return false;
+        }
+
+        LOG_INFO("VFS::MOUNT: {0} at '{1}' ({2} entries)", archivePath, mount->mountPoint, mount->archive.GetEntryCount());
+
+        std::unique_lock<std::shared_mutex> lock(s_mountMutex);
+        s_mounts.push_back(std::move(mount));
+        s_mountCount.store(s_mounts.size(), std::memory_order_release);
+        return true;
+    }
+
+    bool VirtualFileSystem::Unmount(const std::string& archivePath)
+    {
+        std::unique_lock<std::shared_mutex> lock(s_mountMutex);
+        auto it = std::find_if(s_mounts.begin(), s_mounts.end(),
+            [&](const std::unique_ptr<MountedArchive>& mount) { return mount->archivePath == archivePath; });
+        if (it == s_mounts.end()) return false;
+
+        s_mounts.erase(it);
+        s_mountCount.store(s_mounts.size(), std::memory_order_release);
+        return true;
+    }
+
+    void VirtualFileSystem::UnmountAll()
+    {
+        std::unique_lock<std::shared_mutex> lock(s_mountMutex);
+        s_mounts.clear();
+        s_mountCount.store(0, std::memory_order_release);
+    }
+
+    bool VirtualFileSystem::Contains(const std::string& path)
+    {
+        return ResolveArchived(path, [](const PakArchive&, const PakEntry&) {});
+    }
+
+    bool VirtualFileSystem::GetSize(const std::string& path, uint64_t& size)
+    {
+        return ResolveArchived(path, [&](const PakArchive&, const PakEntry& entry) {
+            size = entry.size;
+        });
+    }
+
+    bool VirtualFileSystem::Read(const std::string& path, std::vector<uint8_t>& out)
+    {
+        bool bSuccess = false;
+        const bool bFound = ResolveArchived(path, [&](const PakArchive& archive, const PakEntry& entry) {
+            bSuccess = archive.Read(entry, out);
+        });
+        return bFound && bSuccess;
+    }
+
+    std::span<const std::byte> VirtualFileSystem::GetView(const std::string& path)
+    {
+        std::span<const std::byte> view;
+        ResolveArchived(path, [&](const PakArchive& archive, const PakEntry& entry) {
+            view = archive.GetView(entry);
+        });
+        return view;
+    }
+
     // AsyncFile Implementation
 
-    void AsyncFile::ReadBinaryAsync(const std::string& path, 
-                                    ReadCallback onSuccess,
-                                    ErrorCallback onError) 
+    struct AsyncRequestState
     {
-        std::thread([path, onSuccess, onError]() {
-            try {
-                auto data = File::ReadBinary(path);
-                if (data.empty() && onError) {
-                    onError("Failed to read file: " + path);
-                } else if (onSuccess) {
-                    onSuccess(std::move(data));
+        uint64_t id = 0;
+        uint64_t sequence = 0;
+        std::string path;
+        AsyncPriority priority = AsyncPriority::Normal;
+        bool deliverOnMainThread = false;
+        std::optional<CancellationToken> token;
+
+        AsyncFile::ReadCallback onSuccess;
+        AsyncFile::ErrorCallback onError;
+
+        std::atomic<AsyncStatus> status { AsyncStatus::Pending };
+        AsyncStatus result = AsyncStatus::Pending;
+        // Read finished, callbacks queued for the main thread. Guarded by mutex.
+        bool bAwaitingDelivery = false;
+        std::atomic<bool> cancelled { false };
+        std::vector<uint8_t> data;
+        std::string error;
+
+        std::mutex mutex;
+        std::condition_variable done;
+
+        bool IsCancelled() const
+        {
+            return cancelled.load() || (token && token->IsCancelled());
+        }
+    };
+
+    namespace
+    {
+        using RequestPtr = std::shared_ptr<AsyncRequestState>;
+
+        struct RequestOrder
+        {
+            // Highest priority first, FIFO within a priority.
+            bool operator()(const RequestPtr& a, const RequestPtr& b) const
+            {
+                if (a->priority != b->priority) return a->priority < b->priority;
+                return a->sequence > b->sequence;
+            }
+        };
+
+        class IOWorkerPool
+        {
+        public:
+            ~IOWorkerPool() { Stop(); }
+
+            void Start(uint32_t workerCount, AsyncBackend backend)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_workers.empty()) return;
+
+                m_bStop = false;
+
+                if (backend != AsyncBackend::ThreadPool && StartIoUring()) {
+                    m_backend = AsyncBackend::IoUring;
+                    m_workers.emplace_back([this]() { ReactorMain(); });
+                    return;
+                }
+                if (backend == AsyncBackend::IoUring) {
+                    LOG_WARN("WARNING::ASYNC_FILE::IO_URING_UNAVAILABLE, falling back to thread pool");
+                }
+
+                if (workerCount == 0) {
+                    workerCount = std::clamp(std::thread::hardware_concurrency() / 2, 2u, 4u);
+                }
+
+                m_backend = AsyncBackend::ThreadPool;
+                for (uint32_t i = 0; i < workerCount; ++i) {
+                    m_workers.emplace_back([this, i]() { WorkerMain(i); });
+                }
+            }
+
+            void Stop()
+            {
+                std::vector<std::thread> workers;
+                std::vector<RequestPtr> dropped;
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_bStop = true;
+                    workers.swap(m_workers);
+                    while (!m_queue.empty()) {
+                        dropped.push_back(m_queue.top());
+                        m_queue.pop();
+                    }
+                }
+                Wake(true);
+
+                for (auto& worker : workers) {
+                    worker.join();
+                }
+                StopIoUring();
+
+                {
+                    // Nobody will deliver these any more; release their waiters.
+                    std::lock_guard<std::mutex> lock(m_completedMutex);
+                    for (auto& [id, request] : m_completed) {
+                        dropped.push_back(std::move(request));
+                    }
+                    m_completed.clear();
+                }
+
+                for (auto& request : dropped) {
+                    Finish(request, AsyncStatus::Cancelled);
+                }
+            }
+
+            void Submit(RequestPtr request)
+            {
+                Start(0, AsyncBackend::Auto);
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    request->sequence = m_nextSequence++;
+                    m_queue.push(std::move(request));
+                }
+                Wake(false);
+            }
+
+            AsyncBackend GetBackend()
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                return m_backend;
+            }
+
+            void SetDispatch(AsyncFile::MainThreadDispatch dispatch)
+            {
+                std::lock_guard<std::mutex> lock(m_completedMutex);
+                m_dispatch = std::move(dispatch);
+            }
+
+            void Deliver(uint64_t id)
+            {
+                RequestPtr request;
+                {
+                    std::lock_guard<std::mutex> lock(m_completedMutex);
+                    auto it = m_completed.find(id);
+                    if (it == m_completed.end()) return;
+                    request = std::move(it->second);
+                    m_completed.erase(it);
+                }
+                InvokeCallbacks(*request);
+                Finish(request, request->IsCancelled() ? AsyncStatus::Cancelled : request->result);
+            }
+
+            static void Finish(const RequestPtr& request, AsyncStatus status)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(request->mutex);
+                    request->status.store(status);
+                }
+                request->done.notify_all();
+            }
+
+        private:
+            void Wake(bool all)
+            {
+#if defined(__linux__)
+                if (m_wakeFd >= 0) {
+                    const uint64_t one = 1;
+                    [[maybe_unused]] ssize_t written = write(m_wakeFd, &one, sizeof(one));
+                    return;
+                }
+#endif
+                if (all) m_wake.notify_all();
+                else m_wake.notify_one();
+            }
+
+            void WorkerMain(uint32_t index)
+            {
+                const std::string name = "IO Worker " + std::to_string(index);
+                EverEngine::Profiler::set_thread_name(name.c_str());
+
+                for (;;) {
+                    RequestPtr request;
+                    {
+                        std::unique_lock<std::mutex> lock(m_mutex);
+                        m_wake.wait(lock, [this]() { return m_bStop || !m_queue.empty(); });
+                        if (m_bStop) return;
+                        request = m_queue.top();
+                        m_queue.pop();
+                    }
+                    Process(request);
+                }
+            }
+
+            void Process(const RequestPtr& request)
+            {
+                if (request->IsCancelled()) {
+                    Finish(request, AsyncStatus::Cancelled);
+                    return;
+                }
+
+                request->status.store(AsyncStatus::Running);
+                request->data = File::ReadBinary(request->path);
+                Complete(request, request->data.empty() ? AsyncStatus::Failed : AsyncStatus::Completed);
+            }
+
+            void Complete(const RequestPtr& request, AsyncStatus status)
+            {
+                if (request->IsCancelled()) {
+                    request->data = {};
+                    status = AsyncStatus::Cancelled;
+                } else if (status == AsyncStatus::Failed && request->error.empty()) {
+                    request->error = "Failed to read file: " + request->path;
+                }
+
+                request->result = status;
+
+                // Waiters are only released once the callbacks have run, so
+                // they never see data that a callback is about to move out.
+                // Main-thread requests are finished by Deliver.
+                if (status != AsyncStatus::Cancelled && request->deliverOnMainThread &&
+                    QueueForMainThread(request)) {
+                    return;
+                }
+
+                if (status != AsyncStatus::Cancelled) {
+                    InvokeCallbacks(*request);
+                }
+                Finish(request, status);
+            }
+
+            // Parks the request until the main thread delivers it. Returns
+            // false when there is no hook and the callbacks must run here.
+            bool QueueForMainThread(const RequestPtr& request)
+            {
+                // The hook fails while the main thread's queue is full; retry
+                // for a few frames before giving up on the request.
+                static constexpr int MaxDispatchAttempts = 100;
+                static constexpr auto DispatchRetryDelay = std::chrono::milliseconds(1);
+
+                std::unique_lock<std::mutex> lock(m_completedMutex);
+                if (!m_dispatch) {
+                    LOG_ERROR("ERROR::ASYNC_FILE::NO_MAIN_THREAD_DISPATCH: {0}, running callbacks on the I/O thread",
+                        request->path);
+                    return false;
+                }
+                m_completed.emplace(request->id, request);
+                AsyncFile::MainThreadDispatch dispatch = m_dispatch;
+                lock.unlock();
+
+                {
+                    std::lock_guard<std::mutex> stateLock(request->mutex);
+                    request->bAwaitingDelivery = true;
+                }
+                request->done.notify_all();
+
+                for (int attempt = 0; attempt < MaxDispatchAttempts; ++attempt) {
+                    if (dispatch(request->id)) {
+                        return true;
+                    }
+                    std::this_thread::sleep_for(DispatchRetryDelay);
+                }
+
+                lock.lock();
+                const bool bStillParked = m_completed.erase(request->id) != 0;
+                lock.unlock();
+                if (!bStillParked) {
+                    // A waiter delivered it in the meantime.
+                    return true;
+                }
+
+                LOG_ERROR("ERROR::ASYNC_FILE::MAIN_THREAD_QUEUE_FULL: {0}", request->path);
+                request->error = "Main thread event queue full: " + request->path;
+                request->data = {};
+                request->result = AsyncStatus::Failed;
+                Finish(request, AsyncStatus::Failed);
+                return true;
+            }
+
+            static void InvokeCallbacks(AsyncRequestState& request)
+            {
+                if (request.IsCancelled()) return;
+
+                if (request.result == AsyncStatus::Completed) {
+                    if (request.onSuccess) {
+                        request.onSuccess(std::move(request.data));
+                    }
+                } else if (request.onError) {
+                    request.onError(request.error);
+                }
+            }
+
+#if defined(__linux__)
+            // io_uring backend: a single reactor thread keeps up to
+            // MaxInFlight reads queued in the kernel and submits new ones in
+            // batches with one io_uring_enter per loop. Small files are read
+            // into pre-registered buffers (IORING_OP_READ_FIXED), which saves
+            // the kernel from pinning the destination pages for every read.
+            // The reactor only submits and reaps; helpers do the blocking
+            // work around each read.
+            static constexpr unsigned RingEntries = 256;
+            static constexpr unsigned MaxInFlight = 128;
+            static constexpr unsigned FixedBufferCount = 32;
+            static constexpr size_t FixedBufferSize = 64 * 1024;
+            static constexpr uint64_t WakeTag = 0;
+
+            // Helpers open files, read archived ones and run completions.
+            static constexpr unsigned HelperCount = 2;
+
+            struct InFlightRead
+            {
+                RequestPtr request;
+                int fd = -1;
+                size_t size = 0;
+                size_t done = 0;
+                int fixedBuffer = -1;
+            };
+
+            // A file opened by a helper, waiting for the reactor to read it.
+            struct PreparedRead
+            {
+                RequestPtr request;
+                int fd = -1;
+                size_t size = 0;
+                // Small files are left for the reactor to put in a fixed buffer.
+                bool bDataSized = false;
+            };
+
+            // Pending status: open the file; any other: complete with it.
+            struct HelperTask
+            {
+                RequestPtr request;
+                AsyncStatus status = AsyncStatus::Pending;
+            };
+
+            bool StartIoUring()
+            {
+                if (!m_ring.Init(RingEntries)) {
+                    return false;
+                }
+
+                // Old kernels accept the ring but fail these at submit time.
+                for (uint8_t opcode : { IORING_OP_READ, IORING_OP_READ_FIXED, IORING_OP_POLL_ADD }) {
+                    if (!m_ring.IsOpSupported(opcode)) {
+                        LOG_WARN("WARNING::ASYNC_FILE::IO_URING_OP_UNSUPPORTED: {0}", static_cast<int>(opcode));
+                        m_ring.Destroy();
+                        return false;
+                    }
+                }
+
+                m_fixedBuffers.resize(FixedBufferCount * FixedBufferSize);
+                std::vector<iovec> iov(FixedBufferCount);
+                for (unsigned i = 0; i < FixedBufferCount; ++i) {
+                    iov[i].iov_base = m_fixedBuffers.data() + i * FixedBufferSize;
+                    iov[i].iov_len = FixedBufferSize;
+                }
+                m_bFixedBuffers = m_ring.RegisterBuffers(iov.data(), FixedBufferCount);
+
+                m_wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+                if (m_wakeFd < 0) {
+                    m_ring.Destroy();
+                    return false;
+                }
+
+                m_bHelpersStop = false;
+                for (uint32_t i = 0; i < HelperCount; ++i) {
+                    m_helpers.emplace_back([this, i]() { HelperMain(i); });
+                }
+                return true;
+            }
+
+            void StopIoUring()
+            {
+                // After the reactor: its last completions are still queued.
+                StopHelpers();
+                if (m_wakeFd >= 0) {
+                    close(m_wakeFd);
+                    m_wakeFd = -1;
+                }
+                m_ring.Destroy();
+            }
+
+            void ArmWakeup()
+            {
+                io_uring_sqe* sqe = m_ring.GetSqe();
+                sqe->opcode = IORING_OP_POLL_ADD;
+                sqe->fd = m_wakeFd;
+                sqe->poll32_events = POLLIN;
+                sqe->user_data = WakeTag;
+            }
+
+            void QueueRead(std::vector<InFlightRead>& slots, unsigned slot)
+            {
+                InFlightRead& read = slots[slot];
+                io_uring_sqe* sqe = m_ring.GetSqe();
+
+                sqe->fd = read.fd;
+                sqe->off = read.done;
+                sqe->user_data = slot + 1;
+
+                if (read.fixedBuffer >= 0) {
+                    sqe->opcode = IORING_OP_READ_FIXED;
+                    sqe->addr = reinterpret_cast<uint64_t>(m_fixedBuffers.data() +
+                        read.fixedBuffer * FixedBufferSize + read.done);
+                    sqe->buf_index = static_cast<uint16_t>(read.fixedBuffer);
+                } else {
+                    sqe->opcode = IORING_OP_READ;
+                    sqe->addr = reinterpret_cast<uint64_t>(read.request->data.data() + read.done);
+                }
+                sqe->len = static_cast<uint32_t>(std::min<size_t>(read.size - read.done, 1u << 30));
+            }
+
+            // Runs on a helper. Opens the file, or reads it straight away when
+            // it lives in a mounted archive, so the reactor never blocks on
+            // the filesystem or on decompression.
+            void PrepareRead(const RequestPtr& request)
+            {
+                PreparedRead prepared { request };
+                bool bReady = false;
+
+                if (request->IsCancelled()) {
+                    Finish(request, AsyncStatus::Cancelled);
+                } else {
+                    request->status.store(AsyncStatus::Running);
+
+                    if (VirtualFileSystem::Read(request->path, request->data)) {
+                        Complete(request, AsyncStatus::Completed);
+                    } else {
+                        prepared.fd = open(request->path.c_str(), O_RDONLY | O_CLOEXEC);
+                        struct stat st;
+                        if (prepared.fd < 0 || fstat(prepared.fd, &st) != 0 || st.st_size <= 0) {
+                            if (prepared.fd >= 0) close(prepared.fd);
+                            Complete(request, AsyncStatus::Failed);
+                        } else {
+                            prepared.size = static_cast<size_t>(st.st_size);
+                            if (!m_bFixedBuffers || prepared.size > FixedBufferSize) {
+                                request->data.resize(prepared.size);
+                                prepared.bDataSized = true;
+                            }
+                            bReady = true;
+                        }
+                    }
                 }
-            } catch (const std::exception& e) {
-                if (onError) {
-                    onError(std::string("Exception: ") + e.what());
+
+                {
+                    std::lock_guard<std::mutex> lock(m_helperMutex);
+                    if (bReady) {
+                        m_prepared.push_back(std::move(prepared));
+                    }
+                    --m_preparing;
+                }
+                Wake(false);
+            }
+
+            void PushHelperTask(RequestPtr request, AsyncStatus status)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_helperMutex);
+                    m_helperTasks.push_back({ std::move(request), status });
                 }
+                m_helperWake.notify_one();
             }
-        }).detach();
+
+            void HelperMain(uint32_t index)
+            {
+                const std::string name = "IO Helper " + std::to_string(index);
+                EverEngine::Profiler::set_thread_name(name.c_str());
+
+                for (;;) {
+                    HelperTask task;
+                    {
+                        std::unique_lock<std::mutex> lock(m_helperMutex);
+                        m_helperWake.wait(lock, [this]() { return m_bHelpersStop || !m_helperTasks.empty(); });
+                        // Queued completions still run when stopping.
+                        if (m_helperTasks.empty()) return;
+                        task = std::move(m_helperTasks.front());
+                        m_helperTasks.pop_front();
+                    }
+
+                    if (task.status == AsyncStatus::Pending) {
+                        PrepareRead(task.request);
+                    } else {
+                        Complete(task.request, task.status);
+                    }
+                }
+            }
+
+            void StopHelpers()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_helperMutex);
+                    m_bHelpersStop = true;
+                }
+                m_helperWake.notify_all();
+
+                for (auto& helper : m_helpers) {
+                    helper.join();
+                }
+                m_helpers.clear();
+            }
+
+            void ReactorMain()
+            {
+                EverEngine::Profiler::set_thread_name("IO Reactor");
+
+                std::vector<InFlightRead> slots(MaxInFlight);
+                std::vector<unsigned> freeSlots;
+                for (unsigned i = MaxInFlight; i > 0; --i) freeSlots.push_back(i - 1);
+                std::vector<int> freeFixed;
+                for (int i = FixedBufferCount; i > 0; --i) freeFixed.push_back(i - 1);
+
+                std::vector<RequestPtr> batch;
+                batch.reserve(MaxInFlight);
+                std::vector<PreparedRead> prepared;
+                prepared.reserve(MaxInFlight);
+                bool bWakeArmed = false;
+
+                for (;;) {
+                    // Every request handed to the helpers keeps a slot
+                    // reserved until its read starts or it completes.
+                    unsigned preparing = 0;
+                    {
+                        std::lock_guard<std::mutex> lock(m_helperMutex);
+                        prepared.swap(m_prepared);
+                        preparing = m_preparing;
+                    }
+
+                    for (PreparedRead& ready : prepared) {
+                        const unsigned slot = freeSlots.back();
+                        freeSlots.pop_back();
+
+                        InFlightRead& read = slots[slot];
+                        read.request = std::move(ready.request);
+                        read.fd = ready.fd;
+                        read.size = ready.size;
+                        read.done = 0;
+                        read.fixedBuffer = -1;
+                        if (!ready.bDataSized) {
+                            if (!freeFixed.empty()) {
+                                read.fixedBuffer = freeFixed.back();
+                                freeFixed.pop_back();
+                            } else {
+                                read.request->data.resize(read.size);
+                            }
+                        }
+                        QueueRead(slots, slot);
+                    }
+                    prepared.clear();
+
+                    bool bStopping = false;
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        bStopping = m_bStop;
+                        while (!bStopping && !m_queue.empty() && preparing + batch.size() < freeSlots.size()) {
+                            batch.push_back(m_queue.top());
+                            m_queue.pop();
+                        }
+                    }
+
+                    if (!batch.empty()) {
+                        {
+                            std::lock_guard<std::mutex> lock(m_helperMutex);
+                            m_preparing += static_cast<unsigned>(batch.size());
+                            for (RequestPtr& request : batch) {
+                                m_helperTasks.push_back({ std::move(request), AsyncStatus::Pending });
+                            }
+                        }
+                        m_helperWake.notify_all();
+                        preparing += static_cast<unsigned>(batch.size());
+                        batch.clear();
+                    }
+
+                    const bool bIdle = freeSlots.size() == MaxInFlight && preparing == 0;
+                    if (bStopping && bIdle) {
+                        break;
+                    }
+                    if (!bWakeArmed) {
+                        ArmWakeup();
+                        bWakeArmed = true;
+                    }
+
+                    m_ring.Submit(1);
+
+                    m_ring.ForEachCompletion([&](uint64_t userData, int32_t result) {
+                        if (userData == WakeTag) {
+                            uint64_t value;
+                            [[maybe_unused]] ssize_t drained = ::read(m_wakeFd, &value, sizeof(value));
+                            bWakeArmed = false;
+                            return;
+                        }
+
+                        const unsigned slot = static_cast<unsigned>(userData - 1);
+                        InFlightRead& read = slots[slot];
+
+                        if (result > 0) {
+                            read.done += static_cast<size_t>(result);
+                            if (read.done < read.size) {
+                                QueueRead(slots, slot);
+                                return;
+                            }
+                        }
+
+                        AsyncStatus status = AsyncStatus::Completed;
+                        if (result < 0) {
+                            read.request->error = "Failed to read file: " + read.request->path +
+                                " (" + std::strerror(-result) + ")";
+                            status = AsyncStatus::Failed;
+                        }
+                        if (read.fixedBuffer >= 0) {
+                            const uint8_t* src = m_fixedBuffers.data() + read.fixedBuffer * FixedBufferSize;
+                            read.request->data.assign(src, src + read.done);
+                            freeFixed.push_back(read.fixedBuffer);
+                        } else {
+                            read.request->data.resize(read.done);
+                        }
+                        if (read.done == 0) {
+                            status = AsyncStatus::Failed;
+                        }
+
+                        close(read.fd);
+                        // Callbacks may be slow; keep them off the reactor.
+                        PushHelperTask(std::move(read.request), status);
+                        read = {};
+                        freeSlots.push_back(slot);
+                    });
+                }
+            }
+
+            Platform::IoUring m_ring;
+            std::vector<uint8_t> m_fixedBuffers;
+            bool m_bFixedBuffers = false;
+            int m_wakeFd = -1;
+
+            std::mutex m_helperMutex;
+            std::condition_variable m_helperWake;
+            std::deque<HelperTask> m_helperTasks;
+            std::vector<PreparedRead> m_prepared;
+            unsigned m_preparing = 0;
+            bool m_bHelpersStop = false;
+            std::vector<std::thread> m_helpers;
+#else
+            bool StartIoUring() { return false; }
+            void StopIoUring() {}
+            void ReactorMain() {}
+#endif
+
+            std::mutex m_mutex;
+            std::condition_variable m_wake;
+            std::priority_queue<RequestPtr, std::vector<RequestPtr>, RequestOrder> m_queue;
+            std::vector<std::thread> m_workers;
+            AsyncBackend m_backend = AsyncBackend::ThreadPool;
+            uint64_t m_nextSequence = 0;
+            bool m_bStop = false;
+
+            std::mutex m_completedMutex;
+            std::unordered_map<uint64_t, RequestPtr> m_completed;
+            AsyncFile::MainThreadDispatch m_dispatch;
+        };
+
+        IOWorkerPool s_ioPool;
+        std::atomic<uint64_t> s_nextRequestId { 1 };
+        const std::vector<uint8_t> s_emptyData;
+        const std::string s_emptyString;
     }
-}
 
+    uint64_t AsyncRequest::GetId() const
+    {
+        return m_state ? m_state->id : 0;
+    }
+
+    AsyncStatus AsyncRequest::GetStatus() const
+    {
+        return m_state ? m_state->status.load() : AsyncStatus::Cancelled;
+    }
+
+    bool AsyncRequest::IsDone() const
+    {
+        const AsyncStatus status = GetStatus();
+        return status != AsyncStatus::Pending && status != AsyncStatus::Running;
+    }
+
+    void AsyncRequest::Cancel()
+    {
+        if (m_state) {
+            m_state->cancelled.store(true);
+        }
+    }
+
+    AsyncStatus AsyncRequest::Wait() const
+    {
+        if (!m_state) return AsyncStatus::Cancelled;
+
+        std::unique_lock<std::mutex> lock(m_state->mutex);
+        m_state->done.wait(lock, [this]() { return IsDone() || m_state->bAwaitingDelivery; });
+        if (!IsDone()) {
+            // The callbacks are queued for the main thread, which may be the
+            // one waiting here; run them now instead of waiting for a frame.
+            lock.unlock();
+            s_ioPool.Deliver(m_state->id);
+            lock.lock();
+            m_state->done.wait(lock, [this]() { return IsDone(); });
+        }
+        return m_state->status.load();
+    }
+
+    const std::vector<uint8_t>& AsyncRequest::GetData() const
+    {
+        if (!m_state || !IsDone()) return s_emptyData;
+        return m_state->data;
+    }
+
+    const std::string& AsyncRequest::GetError() const
+    {
+        if (!m_state || !IsDone()) return s_emptyString;
+        return m_state->error;
+    }
+
+    void AsyncFile::Initialize(uint32_t workerCount, AsyncBackend backend)
+    {
+        s_ioPool.Start(workerCount, backend);
+    }
+
+    AsyncBackend AsyncFile::GetBackend()
+    {
+        return s_ioPool.GetBackend();
+    }
+
+    void AsyncFile::Shutdown()
+    {
+        s_ioPool.Stop();
+    }
+
+    AsyncRequest AsyncFile::ReadBinaryAsync(const std::string& path, 
+                                    ReadCallback onSuccess,
+                                    ErrorCallback onError,
+                                    const AsyncReadOptions& options) 
+    {
+        auto request = std::make_shared<AsyncRequestState>();
+        request->id = s_nextRequestId.fetch_add(1);
+        request->path = path;
+        request->priority = options.priority;
+        request->deliverOnMainThread = options.deliverOnMainThread;
+        request->onSuccess = std::move(onSuccess);
+        request->onError = std::move(onError);
+        if (options.cancellationToken) {
+            request->token = *options.cancellationToken;
+        }
+
+        s_ioPool.Submit(request);
+        return AsyncRequest(std::move(request));
+    }
+
+    void AsyncFile::SetMainThreadDispatch(MainThreadDispatch dispatch)
+    {
+        s_ioPool.SetDispatch(std::move(dispatch));
+    }
+
+    void AsyncFile::DeliverCompletion(uint64_t requestId)
+    {
+        s_ioPool.Deliver(requestId);
+    }
+}
@@ -2,9 +2,19 @@
 #define FILE_SYSTEM_HPP
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <functional>
 #include <cstdint>
+#include <memory>
+#include <atomic>
+#include <span>
+#include <cstddef>
+
+namespace EverEngine
+{
+    class JobSystem;
+}
 
 namespace FileSystem
 {
@@ -19,12 +29,81 @@ namespace FileSystem
         static std::string GetFilenameWithoutExtension(const std::string& path);
         static bool IsAbsolute(const std::string& path);
 
+        // '*' and '?' stop at '/', "**" crosses directories and "**/" also
+        // matches no directory at all, e.g. "shaders/**/*.glsl".
+        static bool MatchGlob(std::string_view pattern, std::string_view path);
+
         static const char Separator;
     };
 
+    struct FileInfo
+    {
+        bool exists = false;
+        bool isDirectory = false;
+        // Served from a mounted archive rather than the disk.
+        bool isArchived = false;
+        uint64_t size = 0;
+        // Same units as File::GetLastModifiedTime; 0 for archived entries.
+        uint64_t lastModified = 0;
+    };
+
+    enum class MapAccess
+    {
+        Normal,
+        Sequential,
+        Random,
+    };
+
+    struct MappedFileOptions
+    {
+        MapAccess access = MapAccess::Normal;
+        // Starts reading the whole file in ahead of the first access.
+        bool prefetch = false;
+        // Asks for transparent huge pages where the kernel supports them for
+        // file mappings; ignored otherwise.
+        bool hugePages = false;
+    };
+
+    // Read-only memory mapping of a whole file. The view stays valid until the
+    // MappedFile is closed, moved from or destroyed.
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool Open(const std::string& path, const MappedFileOptions& options = {});
+        void Close();
+
+        bool IsOpen() const { return m_bOpen; }
+        size_t GetSize() const { return m_size; }
+        std::span<const std::byte> GetData() const { return { static_cast<const std::byte*>(m_pData), m_size }; }
+        std::string_view GetText() const { return { static_cast<const char*>(m_pData), m_size }; }
+
+        // Re-applies an access hint to part of the mapping, e.g. Sequential
+        // for a block that is about to be streamed.
+        void Advise(size_t offset, size_t size, MapAccess access, bool prefetch = false) const;
+
+    private:
+        const void* m_pData = nullptr;
+        size_t m_size = 0;
+        bool m_bOpen = false;
+        // File mapping handle on Windows; unused on POSIX.
+        void* m_hMapping = nullptr;
+    };
+
     class File
     {
     public:
+        // One stat (or cache lookup) per call; the queries below are built
+        // on it and never open the file.
+        static FileInfo GetInfo(const std::string& path);
+
         static bool Exists(const std::string& path);
         static bool IsFile(const std::string& path);
         static bool IsDirectory(const std::string& path);
@@ -35,6 +114,8 @@ namespace FileSystem
         static std::vector<uint8_t> ReadBinary(const std::string& path);
         static std::string ReadText(const std::string& path);
         static std::vector<std::string> ReadLines(const std::string& path);
+        // Zero-copy alternative to ReadBinary for large files.
+        static MappedFile Map(const std::string& path, const MappedFileOptions& options = {});
 
         static bool WriteBinary(const std::string& path, const void* data, size_t size);
         static bool WriteText(const std::string& path, const std::string& data);
@@ -46,6 +127,76 @@ namespace FileSystem
         static bool Rename(const std::string& oldPath, const std::string& newPath);
     };
 
+    // Path-keyed cache for File::GetInfo and the queries built on it.
+    // Disabled by default. Entries are dropped by writes made through File
+    // and Directory, by Invalidate (e.g. from a file watcher) and by Refresh.
+    // Changes made behind the engine's back are not seen until then.
+    class MetadataCache
+    {
+    public:
+        static void SetEnabled(bool bEnabled);
+        static bool IsEnabled();
+
+        static void Invalidate(const std::string& path);
+        static void Refresh();
+
+        static size_t GetEntryCount();
+    };
+
+    enum class EntryType : uint8_t
+    {
+        File,
+        Directory,
+        Other,
+    };
+
+    struct DirectoryEntry
+    {
+        uint32_t pathOffset;
+        uint32_t pathLength;
+        // Start of the file name within the path.
+        uint32_t nameOffset;
+        EntryType type;
+    };
+
+    // Flat enumeration result: one entry array and one string arena instead
+    // of a heap-allocated std::string per entry.
+    class DirectoryListing
+    {
+    public:
+        size_t GetCount() const { return m_entries.size(); }
+        bool IsEmpty() const { return m_entries.empty(); }
+
+        const DirectoryEntry& GetEntry(size_t index) const { return m_entries[index]; }
+        std::string_view GetPath(const DirectoryEntry& entry) const { return { m_strings.data() + entry.pathOffset, entry.pathLength }; }
+        std::string_view GetName(const DirectoryEntry& entry) const { return GetPath(entry).substr(entry.nameOffset); }
+
+        std::vector<DirectoryEntry>::const_iterator begin() const { return m_entries.begin(); }
+        std::vector<DirectoryEntry>::const_iterator end() const { return m_entries.end(); }
+
+        void Add(std::string_view path, size_t nameOffset, EntryType type);
+        void Append(const DirectoryListing& other);
+        void SortByPath();
+        void Clear();
+
+    private:
+        std::vector<DirectoryEntry> m_entries;
+        std::vector<char> m_strings;
+    };
+
+    struct DirectoryScanOptions
+    {
+        bool recursive = true;
+        bool includeDirectories = false;
+        // Globs matched against the path relative to the scan root, or against
+        // the file name alone when the pattern has no '/'. An empty include
+        // list accepts everything; excluded directories are not descended.
+        std::vector<std::string> include;
+        std::vector<std::string> exclude;
+        // Subdirectories are scanned as jobs when set, serially otherwise.
+        EverEngine::JobSystem* jobSystem = nullptr;
+    };
+
     class Directory
     {
     public:
@@ -58,21 +209,149 @@ namespace FileSystem
         static std::vector<std::string> ListDirectories(const std::string& path);
         static std::vector<std::string> ListAll(const std::string& path);
 
+        // Single pass over one directory; entry paths are plain names.
+        static bool Enumerate(const std::string& path, DirectoryListing& out);
+        // Entry paths are relative to root, '/'-separated and sorted.
+        static DirectoryListing Scan(const std::string& root, const DirectoryScanOptions& options = {});
+
         static std::string GetCurrent();
         static std::string GetExecutable();
         static std::string GetUserHome();
         static std::string GetTemp();
     };
 
+    // Mounted .pak archives. File::Exists, IsFile, GetSize, ReadBinary,
+    // ReadText and ReadLines look here before touching the disk, newest
+    // mount first, so a mounted archive shadows loose files with the same path.
+    class VirtualFileSystem
+    {
+    public:
+        // Paths under mountPoint resolve into the archive: mounting assets.pak
+        // at "assets" serves "assets/shaders/vertex.vert" from the archive
+        // entry "shaders/vertex.vert". An empty mountPoint mounts at the root.
+        static bool Mount(const std::string& archivePath, const std::string& mountPoint = "");
+        static bool Unmount(const std::string& archivePath);
+        static void UnmountAll();
+
+        static bool Contains(const std::string& path);
+        static bool GetSize(const std::string& path, uint64_t& size);
+        static bool Read(const std::string& path, std::vector<uint8_t>& out);
+
+        // Zero-copy view of a stored (uncompressed) entry. Empty when the path
+        // is not in a mounted archive or the entry is compressed. Valid until
+        // the archive is unmounted.
+        static std::span<const std::byte> GetView(const std::string& path);
+    };
+
+    enum class AsyncPriority
+    {
+        Low = 0,
+        Normal,
+        High,
+        Critical,
+    };
+
+    enum class AsyncStatus
+    {
+        Pending,
+        Running,
+        Completed,
+        Failed,
+        Cancelled,
+    };
+
+    // Shared flag that cancels every request it was passed to, e.g. all
+    // loads belonging to a level that is being unloaded.
+    class CancellationToken
+    {
+    public:
+        CancellationToken() : m_flag(std::make_shared<std::atomic<bool>>(false)) {}
+
+        void Cancel() { m_flag->store(true); }
+        bool IsCancelled() const { return m_flag->load(); }
+
+    private:
+        std::shared_ptr<std::atomic<bool>> m_flag;
+    };
+
+    enum class AsyncBackend
+    {
+        // io_uring where the kernel allows it, thread pool otherwise.
+        Auto,
+        ThreadPool,
+        IoUring,
+    };
+
+    struct AsyncReadOptions
+    {
+        AsyncPriority priority = AsyncPriority::Normal;
+        // Run callbacks on the main thread through the hook installed with
+        // AsyncFile::SetMainThreadDispatch instead of on the I/O worker.
+        bool deliverOnMainThread = false;
+        const CancellationToken* cancellationToken = nullptr;
+    };
+
+    struct AsyncRequestState;
+
+    // Completion handle returned by AsyncFile. Copies refer to the same request.
+    class AsyncRequest
+    {
+    public:
+        AsyncRequest() = default;
+
+        bool IsValid() const { return m_state != nullptr; }
+        uint64_t GetId() const;
+        AsyncStatus GetStatus() const;
+        bool IsDone() const;
+
+        // Pending requests are dropped; a read already in flight finishes but
+        // its callbacks are skipped.
+        void Cancel();
+        // Blocks until the read has finished, failed or been cancelled and
+        // its callbacks have run. Callbacks still queued for the main thread
+        // run on the waiting thread.
+        AsyncStatus Wait() const;
+
+        // Loaded bytes when the request was made without onSuccess; with
+        // onSuccess the data is moved into the callback instead.
+        const std::vector<uint8_t>& GetData() const;
+        const std::string& GetError() const;
+
+    private:
+        friend class AsyncFile;
+        explicit AsyncRequest(std::shared_ptr<AsyncRequestState> state) : m_state(std::move(state)) {}
+
+        std::shared_ptr<AsyncRequestState> m_state;
+    };
+
     class AsyncFile
     {
     public:
         using ReadCallback = std::function<void(std::vector<uint8_t>)>;
         using ErrorCallback = std::function<void(const std::string&)>;
+        // Returns false when the id could not be queued, e.g. a full event ring.
+        using MainThreadDispatch = std::function<bool(uint64_t requestId)>;
 
-        static void ReadBinaryAsync(const std::string& path,
+        // Starts the I/O backend. Called implicitly with the defaults on
+        // first use. workerCount sizes the thread pool (0 picks the default)
+        // and is unused by the io_uring backend.
+        static void Initialize(uint32_t workerCount = 0, AsyncBackend backend = AsyncBackend::Auto);
+        static AsyncBackend GetBackend();
+        // Cancels pending requests and joins the workers.
+        static void Shutdown();
+
+        static AsyncRequest ReadBinaryAsync(const std::string& path,
             ReadCallback onSuccess,
-            ErrorCallback onError = nullptr);
+            ErrorCallback onError = nullptr,
+            const AsyncReadOptions& options = {});
+
+        // Called from an I/O worker when a deliverOnMainThread request is done;
+        // the main thread must then pass the id to DeliverCompletion. A request
+        // whose id cannot be queued after a few retries fails without running
+        // its callbacks. Without a hook the callbacks run on the I/O thread
+        // and an error is logged.
+        static void SetMainThreadDispatch(MainThreadDispatch dispatch);
+        static void DeliverCompletion(uint64_t requestId);
     };
 }
 
@@ -0,0 +1,531 @@
+#include "FileWatcher.hpp"
+#include "FileSystem.hpp"
+#include "EverEngineCore/Log.hpp"
+#include "EverEngineCore/Profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace FileSystem
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        // Folds a new change into one already pending for the same path, e.g.
+        // an editor's delete + recreate becomes a single Modified.
+        // Returns false when the two cancel out.
+        bool MergeChange(FileChangeType& pending, FileChangeType incoming)
+        {
+            if (pending == FileChangeType::Created) {
+                if (incoming == FileChangeType::Removed) return false;
+                return true;
+            }
+            if (pending == FileChangeType::Removed && incoming != FileChangeType::Removed) {
+                pending = FileChangeType::Modified;
+                return true;
+            }
+            pending = incoming;
+            return true;
+        }
+
+        bool IsUnder(const std::string& path, const std::string& root)
+        {
+            return path.size() > root.size() && path.compare(0, root.size(), root) == 0 &&
+                (path[root.size()] == '/' || path[root.size()] == '\\');
+        }
+
+        class WatcherService
+        {
+        public:
+            ~WatcherService() { Stop(); }
+
+            bool Start(const FileWatcherOptions& options)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_thread.joinable()) return true;
+
+                m_options = options;
+                m_bStop = false;
+                m_bPolling = true;
+
+            #if defined(__linux__)
+                if (!options.forcePolling) {
+                    m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+                    m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+                    if (m_inotifyFd >= 0 && m_wakeFd >= 0) {
+                        m_bPolling = false;
+                    } else {
+                        LOG_WARN("WARNING::FILE_WATCHER::INOTIFY_UNAVAILABLE, falling back to polling");
+                        CloseDescriptors();
+                    }
+                }
+            #endif
+
+                for (const std::string& root : m_roots) AddWatches(root, true);
+                for (const std::string& file : m_files) AddWatches(file, false);
+
+                if (m_bPolling) {
+                    m_snapshot = TakeSnapshot();
+                    m_thread = std::thread([this]() { PollMain(); });
+                } else {
+                    m_thread = std::thread([this]() { NotifyMain(); });
+                }
+                return true;
+            }
+
+            void Stop()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (!m_thread.joinable()) return;
+                    m_bStop = true;
+                }
+                Wake();
+                m_thread.join();
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+                CloseDescriptors();
+                m_watches.clear();
+                m_roots.clear();
+                m_files.clear();
+                m_snapshot.clear();
+                m_pending.clear();
+            }
+
+            bool IsRunning()
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                return m_thread.joinable();
+            }
+
+            bool IsPolling()
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                return m_bPolling;
+            }
+
+            bool Watch(const std::string& path)
+            {
+                if (!IsRunning()) Start({});
+
+                const bool bDirectory = File::IsDirectory(path);
+                if (!bDirectory && !File::IsFile(path)) {
+                    LOG_WARN("WARNING::FILE_WATCHER::PATH_NOT_FOUND: {0}", path);
+                    return false;
+                }
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (bDirectory) m_roots.insert(path);
+                else m_files.insert(path);
+
+                AddWatches(path, bDirectory);
+                if (m_bPolling) {
+                    // Seed the snapshot so existing files are not reported as new.
+                    for (auto& [file, state] : TakeSnapshot()) {
+                        m_snapshot.try_emplace(file, state);
+                    }
+                }
+                return true;
+            }
+
+            void Unwatch(const std::string& path)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_roots.erase(path);
+                m_files.erase(path);
+
+            #if defined(__linux__)
+                for (auto it = m_watches.begin(); it != m_watches.end();) {
+                    if (!IsDirectoryNeeded(it->second)) {
+                        inotify_rm_watch(m_inotifyFd, it->first);
+                        it = m_watches.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+            #endif
+                for (auto it = m_snapshot.begin(); it != m_snapshot.end();) {
+                    if (!IsReported(it->first)) it = m_snapshot.erase(it);
+                    else ++it;
+                }
+            }
+
+            void SetDispatch(FileWatcher::Dispatch dispatch)
+            {
+                std::lock_guard<std::mutex> lock(m_dispatchMutex);
+                m_dispatch = std::move(dispatch);
+            }
+
+        private:
+            struct WatchedDirectory
+            {
+                std::string path;
+                // Every file in it is reported, not just explicitly watched ones.
+                bool bAllFiles = false;
+            };
+
+            struct FileState
+            {
+                uint64_t size = 0;
+                uint64_t lastModified = 0;
+
+                bool operator!=(const FileState& other) const
+                {
+                    return size != other.size || lastModified != other.lastModified;
+                }
+            };
+
+            using Snapshot = std::unordered_map<std::string, FileState>;
+
+            // Caller holds m_mutex.
+            bool IsReported(const std::string& path) const
+            {
+                if (m_files.count(path)) return true;
+                for (const std::string& root : m_roots) {
+                    if (IsUnder(path, root)) return true;
+                }
+                return false;
+            }
+
+            bool IsDirectoryNeeded(const WatchedDirectory& directory) const
+            {
+                for (const std::string& root : m_roots) {
+                    if (directory.path == root || IsUnder(directory.path, root)) return true;
+                }
+                for (const std::string& file : m_files) {
+                    if (Path::GetDirectory(file) == directory.path) return true;
+                }
+                return false;
+            }
+
+            void Record(const std::string& path, FileChangeType type)
+            {
+                auto it = m_pending.find(path);
+                if (it == m_pending.end()) {
+                    m_pending.emplace(path, type);
+                } else if (!MergeChange(it->second, type)) {
+                    m_pending.erase(it);
+                }
+                m_lastEvent = Clock::now();
+            }
+
+            void Wake()
+            {
+            #if defined(__linux__)
+                if (m_wakeFd >= 0) {
+                    const uint64_t one = 1;
+                    [[maybe_unused]] ssize_t written = write(m_wakeFd, &one, sizeof(one));
+                }
+            #endif
+                m_wake.notify_all();
+            }
+
+            void CloseDescriptors()
+            {
+            #if defined(__linux__)
+                if (m_inotifyFd >= 0) close(m_inotifyFd);
+                if (m_wakeFd >= 0) close(m_wakeFd);
+                m_inotifyFd = -1;
+                m_wakeFd = -1;
+            #endif
+            }
+
+            // Caller holds m_mutex.
+            void Flush()
+            {
+                if (m_pending.empty()) return;
+
+                std::vector<std::pair<const char*, FileChangeType>> changes;
+                changes.reserve(m_pending.size());
+                for (const auto& [path, type] : m_pending) {
+                    MetadataCache::Invalidate(path);
+                    changes.emplace_back(m_interned.insert(path).first->c_str(), type);
+                }
+                m_pending.clear();
+
+                // Listeners may call back into the watcher.
+                m_mutex.unlock();
+                {
+                    std::lock_guard<std::mutex> lock(m_dispatchMutex);
+                    for (const auto& [path, type] : changes) {
+                        if (m_dispatch) m_dispatch(path, type);
+                    }
+                }
+                m_mutex.lock();
+            }
+
+            // Caller holds m_mutex.
+            void AddWatches(const std::string& path, bool bDirectory)
+            {
+            #if defined(__linux__)
+                if (m_bPolling) return;
+
+                if (!bDirectory) {
+                    // Watch the parent: editors usually save by writing a new
+                    // file and renaming it over the old one, which would drop
+                    // a watch placed on the file itself.
+                    const std::string directory = Path::GetDirectory(path);
+                    AddDirectoryWatch(directory.empty() ? "." : directory, false);
+                    return;
+                }
+
+                AddDirectoryWatch(path, true);
+
+                DirectoryScanOptions options;
+                options.includeDirectories = true;
+                const DirectoryListing listing = Directory::Scan(path, options);
+                for (const DirectoryEntry& entry : listing) {
+                    if (entry.type == EntryType::Directory) {
+                        AddDirectoryWatch(Path::Join(path, std::string(listing.GetPath(entry))), true);
+                    }
+                }
+            #else
+                (void)path;
+                (void)bDirectory;
+            #endif
+            }
+
+        #if defined(__linux__)
+            void AddDirectoryWatch(const std::string& directory, bool bAllFiles)
+            {
+                const uint32_t mask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF;
+                const int wd = inotify_add_watch(m_inotifyFd, directory.c_str(), mask);
+                if (wd < 0) {
+                    LOG_WARN("WARNING::FILE_WATCHER::ADD_WATCH_FAILED: {0}", directory);
+                    return;
+                }
+
+                // Adding the same directory twice returns the same descriptor.
+                WatchedDirectory& watched = m_watches[wd];
+                if (watched.path.empty()) {
+                    // Files explicitly watched in "." are reported without a prefix.
+                    watched.path = directory == "." ? "" : directory;
+                }
+                watched.bAllFiles |= bAllFiles;
+            }
+
+            void HandleNotification(const inotify_event& event)
+            {
+                if (event.mask & IN_Q_OVERFLOW) {
+                    LOG_WARN("WARNING::FILE_WATCHER::QUEUE_OVERFLOW, some changes were lost");
+                    return;
+                }
+
+                auto it = m_watches.find(event.wd);
+                if (it == m_watches.end()) return;
+
+                if (event.mask & IN_IGNORED) {
+                    m_watches.erase(it);
+                    return;
+                }
+                if (event.len == 0) return;
+
+                const WatchedDirectory watched = it->second;
+                const std::string path = watched.path.empty() ? std::string(event.name) : Path::Join(watched.path, event.name);
+
+                if (event.mask & IN_ISDIR) {
+                    if (watched.bAllFiles && (event.mask & (IN_CREATE | IN_MOVED_TO))) {
+                        // Files may land before the watch is in place, so
+                        // report what is already there.
+                        AddWatches(path, true);
+                        const DirectoryListing listing = Directory::Scan(path);
+                        for (const DirectoryEntry& entry : listing) {
+                            Record(Path::Join(path, std::string(listing.GetPath(entry))), FileChangeType::Created);
+                        }
+                    }
+                    return;
+                }
+
+                if (!watched.bAllFiles && !m_files.count(path)) return;
+
+                if (event.mask & (IN_DELETE | IN_MOVED_FROM)) {
+                    Record(path, FileChangeType::Removed);
+                } else if (event.mask & (IN_CREATE | IN_MOVED_TO)) {
+                    Record(path, FileChangeType::Created);
+                } else if (event.mask & IN_CLOSE_WRITE) {
+                    Record(path, FileChangeType::Modified);
+                }
+            }
+
+            void NotifyMain()
+            {
+                EverEngine::Profiler::set_thread_name("File Watcher");
+
+                alignas(inotify_event) char buffer[16 * 1024];
+                pollfd fds[2] = {
+                    { m_inotifyFd, POLLIN, 0 },
+                    { m_wakeFd, POLLIN, 0 },
+                };
+
+                std::unique_lock<std::mutex> lock(m_mutex);
+                while (!m_bStop) {
+                    int timeout = -1;
+                    if (!m_pending.empty()) {
+                        const auto due = m_lastEvent + std::chrono::milliseconds(m_options.debounceMs);
+                        timeout = static_cast<int>(std::max<int64_t>(0,
+                            std::chrono::duration_cast<std::chrono::milliseconds>(due - Clock::now()).count()));
+                    }
+
+                    lock.unlock();
+                    poll(fds, 2, timeout);
+                    lock.lock();
+
+                    if (fds[1].revents & POLLIN) {
+                        uint64_t value;
+                        [[maybe_unused]] ssize_t drained = read(m_wakeFd, &value, sizeof(value));
+                    }
+
+                    for (;;) {
+                        const ssize_t length = read(m_inotifyFd, buffer, sizeof(buffer));
+                        if (length <= 0) break;
+
+                        for (ssize_t offset = 0; offset < length;) {
+                            const inotify_event& event = *reinterpret_cast<const inotify_event*>(buffer + offset);
+                            HandleNotification(event);
+                            offset += sizeof(inotify_event) + event.len;
+                        }
+                    }
+
+                    if (!m_pending.empty() &&
+                        Clock::now() - m_lastEvent >= std::chrono::milliseconds(m_options.debounceMs)) {
+                        Flush();
+                    }
+                }
+            }
+        #else
+            void NotifyMain() {}
+        #endif
+
+            // Caller holds m_mutex.
+            Snapshot TakeSnapshot() const
+            {
+                Snapshot snapshot;
+                auto add = [&](const std::string& file) {
+                    MetadataCache::Invalidate(file);
+                    const FileInfo info = File::GetInfo(file);
+                    if (info.exists && !info.isDirectory && !info.isArchived) {
+                        snapshot[file] = { info.size, info.lastModified };
+                    }
+                };
+
+                for (const std::string& file : m_files) {
+                    add(file);
+                }
+                for (const std::string& root : m_roots) {
+                    const DirectoryListing listing = Directory::Scan(root);
+                    for (const DirectoryEntry& entry : listing) {
+                        add(Path::Join(root, std::string(listing.GetPath(entry))));
+                    }
+                }
+                return snapshot;
+            }
+
+            void PollMain()
+            {
+                EverEngine::Profiler::set_thread_name("File Watcher");
+
+                std::unique_lock<std::mutex> lock(m_mutex);
+                while (!m_bStop) {
+                    m_wake.wait_for(lock, std::chrono::milliseconds(m_options.pollIntervalMs));
+                    if (m_bStop) break;
+
+                    Snapshot current = TakeSnapshot();
+                    for (const auto& [path, state] : current) {
+                        auto it = m_snapshot.find(path);
+                        if (it == m_snapshot.end()) Record(path, FileChangeType::Created);
+                        else if (it->second != state) Record(path, FileChangeType::Modified);
+                    }
+                    for (const auto& [path, state] : m_snapshot) {
+                        if (!current.count(path)) Record(path, FileChangeType::Removed);
+                    }
+                    m_snapshot = std::move(current);
+
+                    // The poll interval already batches changes.
+                    Flush();
+                }
+            }
+
+            std::mutex m_mutex;
+            std::condition_variable m_wake;
+            std::thread m_thread;
+            FileWatcherOptions m_options;
+            bool m_bStop = false;
+            bool m_bPolling = true;
+
+            std::set<std::string> m_roots;
+            std::set<std::string> m_files;
+            std::unordered_map<int, WatchedDirectory> m_watches;
+            Snapshot m_snapshot;
+
+            std::map<std::string, FileChangeType> m_pending;
+            Clock::time_point m_lastEvent;
+            // Node-based, so c_str() pointers handed to listeners stay valid.
+            // Never cleared: events holding them may still be queued after
+            // Stop(). Only paths that were reported land here, and a file
+            // created and removed within one debounce never is, so editors'
+            // temporary files do not grow it.
+            std::unordered_set<std::string> m_interned;
+
+            std::mutex m_dispatchMutex;
+            FileWatcher::Dispatch m_dispatch;
+
+        #if defined(__linux__)
+            int m_inotifyFd = -1;
+            int m_wakeFd = -1;
+        #endif
+        };
+
+        WatcherService s_watcher;
+    }
+
+    bool FileWatcher::Start(const FileWatcherOptions& options)
+    {
+        return s_watcher.Start(options);
+    }
+
+    void FileWatcher::Stop()
+    {
+        s_watcher.Stop();
+    }
+
+    bool FileWatcher::IsRunning()
+    {
+        return s_watcher.IsRunning();
+    }
+
+    bool FileWatcher::IsPolling()
+    {
+        return s_watcher.IsPolling();
+    }
+
+    bool FileWatcher::Watch(const std::string& path)
+    {
+        return s_watcher.Watch(path);
+    }
+
+    void FileWatcher::Unwatch(const std::string& path)
+    {
+        s_watcher.Unwatch(path);
+    }
+
+    void FileWatcher::SetDispatch(Dispatch dispatch)
+    {
+        s_watcher.SetDispatch(std::move(dispatch));
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef FILE_WATCHER_HPP
+#define FILE_WATCHER_HPP
+
+#include <string>
+#include <functional>
+#include <cstdint>
+
+namespace FileSystem
+{
+    enum class FileChangeType : uint8_t
+    {
+        // inotify also reports this for a file replaced by a rename, which is
+        // how many editors save; treat it like Modified for reloading.
+        Created,
+        Modified,
+        Removed,
+    };
+
+    struct FileWatcherOptions
+    {
+        // Changes are held until no new event has arrived for this long, so
+        // an editor's truncate/write/rename sequence is reported once.
+        uint32_t debounceMs = 100;
+        // Used by the polling fallback only.
+        uint32_t pollIntervalMs = 500;
+        // Skips inotify even where it is available.
+        bool forcePolling = false;
+    };
+
+    // Background watcher for asset files. Uses inotify on Linux and falls back
+    // to polling File::GetInfo elsewhere or when inotify is unavailable.
+    // Changes are batched and handed to the dispatch function on the watcher
+    // thread; the application forwards them to the main thread as events.
+    class FileWatcher
+    {
+    public:
+        // path is interned and stays valid for the rest of the process, also
+        // after Stop().
+        using Dispatch = std::function<void(const char* path, FileChangeType type)>;
+
+        static bool Start(const FileWatcherOptions& options = {});
+        static void Stop();
+        static bool IsRunning();
+        static bool IsPolling();
+
+        // A file, or a directory whose files are watched recursively. Paths
+        // are reported joined the same way they were passed in.
+        static bool Watch(const std::string& path);
+        static void Unwatch(const std::string& path);
+
+        static void SetDispatch(Dispatch dispatch);
+    };
+}
+
+#endif
@@ -0,0 +1,279 @@
+#include "PakArchive.hpp"
+#include "Compression.hpp"
+#include "EverEngineCore/Log.hpp"
+#include "EverEngineCore/Profiler.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+
+namespace FileSystem
+{
+    // PAK ARCHIVE
+    bool PakArchive::Open(const std::string& path)
+    {
+        PROFILE_SCOPE("PakArchive::Open");
+
+        Close();
+
+        MappedFileOptions options;
+        options.access = MapAccess::Random;
+        if (!m_file.Open(path, options)) {
+            LOG_ERROR("ERROR::PAK::OPEN_FAILED: {0}", path);
+            return false;
+        }
+
+        const size_t fileSize = m_file.GetSize();
+        const std::byte* base = m_file.GetData().data();
+
+        if (fileSize < sizeof(PakHeader)) {
+            LOG_ERROR("ERROR::PAK::TRUNCATED: {0}", path);
+            Close();
+            return false;
+        }
+
+        const PakHeader* header = reinterpret_cast<const PakHeader*>(base);
+        if (header->magic != PakHeader::Magic || header->version != PakHeader::CurrentVersion) {
+            LOG_ERROR("ERROR::PAK::BAD_HEADER: {0}", path);
+            Close();
+            return false;
+        }
+
+        const uint64_t tocSize = uint64_t(header->entryCount) * sizeof(PakEntry);
+        if (header->tocOffset % alignof(PakEntry) != 0 ||
+            header->tocOffset > fileSize || tocSize > fileSize - header->tocOffset ||
+            header->stringsOffset > fileSize || header->stringsSize > fileSize - header->stringsOffset) {
+            LOG_ERROR("ERROR::PAK::BAD_TABLE_OF_CONTENTS: {0}", path);
+            Close();
+            return false;
+        }
+
+        std::span<const PakEntry> entries(
+            reinterpret_cast<const PakEntry*>(base + header->tocOffset), header->entryCount);
+
+        for (const PakEntry& entry : entries) {
+            if (entry.offset > fileSize || entry.storedSize > fileSize - entry.offset ||
+                uint64_t(entry.pathOffset) + entry.pathLength > header->stringsSize ||
+                (entry.compression == PakCompression::None && entry.storedSize != entry.size) ||
+                (entry.compression != PakCompression::None && entry.compression != PakCompression::LZ4)) {
+                LOG_ERROR("ERROR::PAK::BAD_ENTRY: {0}", path);
+                Close();
+                return false;
+            }
+        }
+
+        m_pHeader = header;
+        m_entries = entries;
+        m_pStrings = reinterpret_cast<const char*>(base + header->stringsOffset);
+        return true;
+    }
+
+    void PakArchive::Close()
+    {
+        m_file.Close();
+        m_pHeader = nullptr;
+        m_entries = {};
+        m_pStrings = nullptr;
+    }
+
+    const PakEntry* PakArchive::Find(std::string_view path) const
+    {
+        if (!m_pHeader) return nullptr;
+
+        const uint64_t hash = HashPath(path);
+        auto it = std::lower_bound(m_entries.begin(), m_entries.end(), hash,
+            [](const PakEntry& entry, uint64_t value) { return entry.pathHash < value; });
+
+        for (; it != m_entries.end() && it->pathHash == hash; ++it) {
+            if (GetPath(*it) == path) {
+                return &*it;
+            }
+        }
+        return nullptr;
+    }
+
+    std::string_view PakArchive::GetPath(const PakEntry& entry) const
+    {
+        return { m_pStrings + entry.pathOffset, entry.pathLength };
+    }
+
+    std::span<const std::byte> PakArchive::GetView(const PakEntry& entry) const
+    {
+        if (entry.compression != PakCompression::None) return {};
+        return m_file.GetData().subspan(entry.offset, entry.size);
+    }
+
+    bool PakArchive::Read(const PakEntry& entry, std::vector<uint8_t>& out) const
+    {
+        const uint8_t* stored = reinterpret_cast<const uint8_t*>(m_file.GetData().data() + entry.offset);
+
+        if (entry.compression == PakCompression::None) {
+            out.assign(stored, stored + entry.size);
+            return true;
+        }
+
+        out.resize(entry.size);
+        if (!Compression::Decompress(stored, entry.storedSize, out.data(), out.size())) {
+            LOG_ERROR("ERROR::PAK::CORRUPT_ENTRY: {0}", GetPath(entry));
+            out.clear();
+            return false;
+        }
+        return true;
+    }
+
+    std::string PakArchive::NormalizePath(std::string_view path)
+    {
+        std::string result(path);
+        std::replace(result.begin(), result.end(), '\\', '/');
+
+        size_t start = 0;
+        while (start < result.size()) {
+            if (result.compare(start, 2, "./") == 0) start += 2;
+            else if (result[start] == '/') start += 1;
+            else break;
+        }
+        return result.substr(start);
+    }
+
+    uint64_t PakArchive::HashPath(std::string_view normalizedPath)
+    {
+        // FNV-1a
+        uint64_t hash = 14695981039346656037ull;
+        for (char c : normalizedPath) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    // PAK WRITER
+    void PakWriter::AddFile(std::string_view archivePath, const std::string& diskPath)
+    {
+        m_files.push_back({ PakArchive::NormalizePath(archivePath), diskPath, {} });
+    }
+
+    void PakWriter::AddData(std::string_view archivePath, std::vector<uint8_t> data)
+    {
+        m_files.push_back({ PakArchive::NormalizePath(archivePath), {}, std::move(data) });
+    }
+
+    bool PakWriter::Write(const std::string& outputPath, const PakWriteOptions& options) const
+    {
+        PROFILE_SCOPE("PakWriter::Write");
+
+        const uint64_t alignment = std::max<uint32_t>(options.alignment, 1);
+        if ((alignment & (alignment - 1)) != 0) {
+            LOG_ERROR("ERROR::PAK::ALIGNMENT_NOT_POWER_OF_TWO: {0}", alignment);
+            return false;
+        }
+
+        std::vector<PakEntry> entries(m_files.size());
+        std::vector<size_t> order(m_files.size());
+        for (size_t i = 0; i < m_files.size(); ++i) {
+            order[i] = i;
+            entries[i].pathHash = PakArchive::HashPath(m_files[i].archivePath);
+        }
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            if (entries[a].pathHash != entries[b].pathHash) return entries[a].pathHash < entries[b].pathHash;
+            return m_files[a].archivePath < m_files[b].archivePath;
+        });
+
+        for (size_t i = 1; i < order.size(); ++i) {
+            if (m_files[order[i]].archivePath == m_files[order[i - 1]].archivePath) {
+                LOG_ERROR("ERROR::PAK::DUPLICATE_PATH: {0}", m_files[order[i]].archivePath);
+                return false;
+            }
+        }
+
+        std::ofstream out(outputPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            LOG_ERROR("ERROR::PAK::CREATE_FAILED: {0}", outputPath);
+            return false;
+        }
+
+        const char zeros[4096] = {};
+        uint64_t position = 0;
+        auto write = [&](const void* data, size_t size) {
+            out.write(static_cast<const char*>(data), size);
+            position += size;
+        };
+        auto pad = [&](uint64_t align) {
+            uint64_t padding = (align - position % align) % align;
+            while (padding > 0) {
+                const size_t chunk = std::min<uint64_t>(padding, sizeof(zeros));
+                write(zeros, chunk);
+                padding -= chunk;
+            }
+        };
+
+        PakHeader header = {};
+        write(&header, sizeof(header));
+
+        std::vector<uint8_t> compressed;
+        std::string strings;
+        std::vector<PakEntry> toc;
+        toc.reserve(order.size());
+
+        for (size_t index : order) {
+            const PendingFile& file = m_files[index];
+            PakEntry entry = entries[index];
+
+            std::vector<uint8_t> diskData;
+            if (!file.diskPath.empty()) {
+                diskData = File::ReadBinary(file.diskPath);
+                if (diskData.empty() && File::GetSize(file.diskPath) != 0) {
+                    LOG_ERROR("ERROR::PAK::READ_FAILED: {0}", file.diskPath);
+                    return false;
+                }
+            }
+            const std::vector<uint8_t>& data = file.diskPath.empty() ? file.data : diskData;
+
+            const uint8_t* stored = data.data();
+            entry.size = data.size();
+            entry.storedSize = data.size();
+            entry.compression = PakCompression::None;
+
+            if (options.compress && !data.empty()) {
+                compressed.resize(Compression::GetBound(data.size()));
+                const size_t compressedSize = Compression::Compress(data.data(), data.size(), compressed.data(), compressed.size());
+                if (compressedSize > 0 && compressedSize < data.size() * options.minCompressionRatio) {
+                    stored = compressed.data();
+                    entry.storedSize = compressedSize;
+                    entry.compression = PakCompression::LZ4;
+                }
+            }
+
+            pad(alignment);
+            entry.offset = position;
+            write(stored, entry.storedSize);
+
+            entry.pathOffset = static_cast<uint32_t>(strings.size());
+            entry.pathLength = static_cast<uint32_t>(file.archivePath.size());
+            entry.reserved = 0;
+            strings += file.archivePath;
+
+            toc.push_back(entry);
+        }
+
+        pad(alignof(PakEntry));
+        header.magic = PakHeader::Magic;
+        header.version = PakHeader::CurrentVersion;
+        header.entryCount = static_cast<uint32_t>(toc.size());
+        header.alignment = static_cast<uint32_t>(alignment);
+        header.tocOffset = position;
+        write(toc.data(), toc.size() * sizeof(PakEntry));
+
+        header.stringsOffset = position;
+        header.stringsSize = strings.size();
+        write(strings.data(), strings.size());
+
+        out.seekp(0);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        if (!out) {
+            LOG_ERROR("ERROR::PAK::WRITE_FAILED: {0}", outputPath);
+            return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,122 @@
+#ifndef PAK_ARCHIVE_HPP
+#define PAK_ARCHIVE_HPP
+
+#include "FileSystem.hpp"
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <cstdint>
+#include <cstddef>
+
+namespace FileSystem
+{
+    // On-disk layout (little-endian):
+    //
+    //   PakHeader
+    //   entry data, each blob aligned to PakHeader::alignment
+    //   PakEntry[entryCount]   sorted by (pathHash, path)
+    //   path strings           not null-terminated
+    //
+    // The table of contents sits at the end so the writer can stream data
+    // out without knowing the final offsets up front.
+    enum class PakCompression : uint32_t
+    {
+        None = 0,
+        LZ4 = 1,
+    };
+
+    struct PakHeader
+    {
+        static constexpr uint32_t Magic = 0x4B415045; // "EPAK"
+        static constexpr uint32_t CurrentVersion = 1;
+
+        uint32_t magic;
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t alignment;
+        uint64_t tocOffset;
+        uint64_t stringsOffset;
+        uint64_t stringsSize;
+    };
+    static_assert(sizeof(PakHeader) == 40);
+
+    struct PakEntry
+    {
+        uint64_t pathHash;
+        uint64_t offset;
+        uint64_t size;
+        uint64_t storedSize;
+        uint32_t pathOffset;
+        uint32_t pathLength;
+        PakCompression compression;
+        uint32_t reserved;
+    };
+    static_assert(sizeof(PakEntry) == 48);
+
+    // Read-only view of a .pak file. The whole archive is memory mapped;
+    // uncompressed entries are handed out as views into the mapping.
+    class PakArchive
+    {
+    public:
+        bool Open(const std::string& path);
+        void Close();
+        bool IsOpen() const { return m_pHeader != nullptr; }
+
+        const PakEntry* Find(std::string_view path) const;
+
+        size_t GetEntryCount() const { return m_entries.size(); }
+        const PakEntry& GetEntry(size_t index) const { return m_entries[index]; }
+        std::string_view GetPath(const PakEntry& entry) const;
+
+        // Zero-copy view of an entry, empty for compressed entries. Valid
+        // until the archive is closed.
+        std::span<const std::byte> GetView(const PakEntry& entry) const;
+
+        // Copies (and decompresses if needed) an entry into out.
+        bool Read(const PakEntry& entry, std::vector<uint8_t>& out) const;
+
+        // Archive paths use '/' and have no leading "./" or "/".
+        static std::string NormalizePath(std::string_view path);
+        static uint64_t HashPath(std::string_view normalizedPath);
+
+    private:
+        MappedFile m_file;
+        const PakHeader* m_pHeader = nullptr;
+        std::span<const PakEntry> m_entries;
+        const char* m_pStrings = nullptr;
+    };
+
+    struct PakWriteOptions
+    {
+        // Power of two. 4096 keeps every entry page aligned in the mapping.
+        uint32_t alignment = 16;
+        bool compress = true;
+        // Entries are stored raw unless compression saves at least this much.
+        float minCompressionRatio = 0.9f;
+    };
+
+    class PakWriter
+    {
+    public:
+        void AddFile(std::string_view archivePath, const std::string& diskPath);
+        void AddData(std::string_view archivePath, std::vector<uint8_t> data);
+
+        bool Write(const std::string& outputPath, const PakWriteOptions& options = {}) const;
+
+        size_t GetEntryCount() const { return m_files.size(); }
+
+    private:
+        struct PendingFile
+        {
+            std::string archivePath;
+            std::string diskPath;
+            std::vector<uint8_t> data;
+        };
+
+        std::vector<PendingFile> m_files;
+    };
+}
+
+#endif
@@ -0,0 +1,199 @@
+#include "IoUring.hpp"
+
+#if defined(__linux__)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <cstring>
+#include <atomic>
+#include <vector>
+#endif
+
+namespace Platform
+{
+#if defined(__linux__)
+
+    namespace
+    {
+        unsigned LoadAcquire(const unsigned* p)
+        {
+            return std::atomic_ref<const unsigned>(*p).load(std::memory_order_acquire);
+        }
+
+        void StoreRelease(unsigned* p, unsigned value)
+        {
+            std::atomic_ref<unsigned>(*p).store(value, std::memory_order_release);
+        }
+    }
+
+    IoUring::~IoUring()
+    {
+        Destroy();
+    }
+
+    bool IoUring::Init(unsigned entries)
+    {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+
+        int fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (fd < 0) {
+            return false;
+        }
+        m_ringFd = fd;
+
+        m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+        const bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (singleMap) {
+            m_sqRingSize = m_cqRingSize = (m_sqRingSize > m_cqRingSize) ? m_sqRingSize : m_cqRingSize;
+        }
+
+        m_sqRing = mmap(nullptr, m_sqRingSize, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE, m_ringFd, IORING_OFF_SQ_RING);
+        if (m_sqRing == MAP_FAILED) {
+            m_sqRing = nullptr;
+            Destroy();
+            return false;
+        }
+
+        if (singleMap) {
+            m_cqRing = m_sqRing;
+        } else {
+            m_cqRing = mmap(nullptr, m_cqRingSize, PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_POPULATE, m_ringFd, IORING_OFF_CQ_RING);
+            if (m_cqRing == MAP_FAILED) {
+                m_cqRing = nullptr;
+                Destroy();
+                return false;
+            }
+        }
+
+        m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE, m_ringFd, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) {
+            Destroy();
+            return false;
+        }
+        m_sqes = static_cast<io_uring_sqe*>(sqes);
+
+        char* sq = static_cast<char*>(m_sqRing);
+        m_sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        m_sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        m_sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        m_sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        m_sqEntries = params.sq_entries;
+        m_sqLocalTail = *m_sqTail;
+        m_sqSubmitted = m_sqLocalTail;
+
+        char* cq = static_cast<char*>(m_cqRing);
+        m_cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        m_cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        m_cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        ProbeOps();
+        return true;
+    }
+
+    void IoUring::ProbeOps()
+    {
+        constexpr unsigned maxOps = 256;
+        std::vector<unsigned char> buffer(sizeof(io_uring_probe) + maxOps * sizeof(io_uring_probe_op), 0);
+        auto* probe = reinterpret_cast<io_uring_probe*>(buffer.data());
+
+        if (syscall(__NR_io_uring_register, m_ringFd, IORING_REGISTER_PROBE, probe, maxOps) != 0) {
+            return;
+        }
+
+        const unsigned count = probe->ops_len < maxOps ? probe->ops_len : maxOps;
+        for (unsigned i = 0; i < count; ++i) {
+            const io_uring_probe_op& op = probe->ops[i];
+            if (op.flags & IO_URING_OP_SUPPORTED) {
+                m_supportedOps[op.op / 64] |= uint64_t(1) << (op.op % 64);
+            }
+        }
+    }
+
+    void IoUring::Destroy()
+    {
+        if (m_sqes) munmap(m_sqes, m_sqesSize);
+        if (m_cqRing && m_cqRing != m_sqRing) munmap(m_cqRing, m_cqRingSize);
+        if (m_sqRing) munmap(m_sqRing, m_sqRingSize);
+        if (m_ringFd >= 0) close(m_ringFd);
+
+        m_sqes = nullptr;
+        m_cqRing = nullptr;
+        m_sqRing = nullptr;
+        m_ringFd = -1;
+        std::memset(m_supportedOps, 0, sizeof(m_supportedOps));
+    }
+
+    bool IoUring::RegisterBuffers(const iovec* buffers, unsigned count)
+    {
+        if (!IsValid()) return false;
+        return syscall(__NR_io_uring_register, m_ringFd, IORING_REGISTER_BUFFERS, buffers, count) == 0;
+    }
+
+    io_uring_sqe* IoUring::GetSqe()
+    {
+        const unsigned head = LoadAcquire(m_sqHead);
+        if (m_sqLocalTail - head >= m_sqEntries) {
+            return nullptr;
+        }
+
+        const unsigned index = m_sqLocalTail & *m_sqMask;
+        io_uring_sqe* sqe = &m_sqes[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        m_sqArray[index] = index;
+        ++m_sqLocalTail;
+        return sqe;
+    }
+
+    int IoUring::Submit(unsigned minComplete)
+    {
+        const unsigned toSubmit = m_sqLocalTail - m_sqSubmitted;
+        StoreRelease(m_sqTail, m_sqLocalTail);
+        m_sqSubmitted = m_sqLocalTail;
+
+        const unsigned flags = minComplete > 0 ? IORING_ENTER_GETEVENTS : 0;
+        return static_cast<int>(syscall(__NR_io_uring_enter, m_ringFd, toSubmit, minComplete,
+            flags, nullptr, 0));
+    }
+
+    bool IoUring::PeekCompletion(uint64_t& userData, int32_t& result)
+    {
+        const unsigned head = *m_cqHead;
+        if (head == LoadAcquire(m_cqTail)) {
+            return false;
+        }
+
+        const io_uring_cqe& cqe = m_cqes[head & *m_cqMask];
+        userData = cqe.user_data;
+        result = cqe.res;
+        return true;
+    }
+
+    void IoUring::AdvanceCompletion()
+    {
+        StoreRelease(m_cqHead, *m_cqHead + 1);
+    }
+
+#else
+
+    IoUring::~IoUring() {}
+    bool IoUring::Init(unsigned) { return false; }
+    void IoUring::Destroy() {}
+    void IoUring::ProbeOps() {}
+    bool IoUring::RegisterBuffers(const iovec*, unsigned) { return false; }
+    io_uring_sqe* IoUring::GetSqe() { return nullptr; }
+    int IoUring::Submit(unsigned) { return -1; }
+    bool IoUring::PeekCompletion(uint64_t&, int32_t&) { return false; }
+    void IoUring::AdvanceCompletion() {}
+
+#endif
+}
@@ -0,0 +1,95 @@
+#ifndef IO_URING_HPP
+#define IO_URING_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+struct iovec;
+
+namespace Platform
+{
+    // Minimal io_uring wrapper over the raw syscalls, so no liburing
+    // dependency is needed. Only usable on Linux; Init() fails elsewhere or
+    // when the kernel refuses io_uring (old kernel, seccomp, containers).
+    class IoUring
+    {
+    public:
+        IoUring() = default;
+        ~IoUring();
+
+        IoUring(const IoUring&) = delete;
+        IoUring& operator=(const IoUring&) = delete;
+
+        bool Init(unsigned entries);
+        void Destroy();
+        bool IsValid() const { return m_ringFd >= 0; }
+
+        unsigned GetEntries() const { return m_sqEntries; }
+
+        // Whether the kernel implements an IORING_OP_* opcode. A ring can be
+        // created on kernels older than most opcodes (READ needs 5.6), so
+        // check every opcode the caller relies on. Kernels without
+        // IORING_REGISTER_PROBE (before 5.6) report nothing as supported.
+        bool IsOpSupported(uint8_t opcode) const
+        {
+            return (m_supportedOps[opcode / 64] >> (opcode % 64)) & 1u;
+        }
+
+        bool RegisterBuffers(const iovec* buffers, unsigned count);
+
+        // Next free submission entry, zeroed, or nullptr when the queue is full.
+        io_uring_sqe* GetSqe();
+
+        // Submits everything queued by GetSqe and waits for at least
+        // minComplete completions. Returns the syscall result.
+        int Submit(unsigned minComplete);
+
+        // Calls func(userData, result) for every available completion.
+        template<typename FuncT>
+        unsigned ForEachCompletion(FuncT&& func)
+        {
+            unsigned count = 0;
+            uint64_t userData = 0;
+            int32_t result = 0;
+            while (PeekCompletion(userData, result))
+            {
+                func(userData, result);
+                AdvanceCompletion();
+                ++count;
+            }
+            return count;
+        }
+
+    private:
+        void ProbeOps();
+        bool PeekCompletion(uint64_t& userData, int32_t& result);
+        void AdvanceCompletion();
+
+        int m_ringFd = -1;
+        uint64_t m_supportedOps[4] = {};
+
+        void* m_sqRing = nullptr;
+        size_t m_sqRingSize = 0;
+        void* m_cqRing = nullptr;
+        size_t m_cqRingSize = 0;
+        io_uring_sqe* m_sqes = nullptr;
+        size_t m_sqesSize = 0;
+
+        unsigned* m_sqHead = nullptr;
+        unsigned* m_sqTail = nullptr;
+        unsigned* m_sqMask = nullptr;
+        unsigned* m_sqArray = nullptr;
+        unsigned m_sqEntries = 0;
+        unsigned m_sqLocalTail = 0;
+        unsigned m_sqSubmitted = 0;
+
+        unsigned* m_cqHead = nullptr;
+        unsigned* m_cqTail = nullptr;
+        unsigned* m_cqMask = nullptr;
+        io_uring_cqe* m_cqes = nullptr;
+    };
+}
+
+#endif // !IO_URING_HPP
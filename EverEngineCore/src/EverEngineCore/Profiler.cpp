@@ -0,0 +1,152 @@
+#include "EverEngineCore/Profiler.hpp"
+#include "EverEngineCore/Log.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace EverEngine
+{
+    namespace
+    {
+        constexpr size_t SamplesPerThread = 1 << 15;
+
+        struct Sample
+        {
+            const char* name;
+            uint64_t start;
+            uint64_t end;
+        };
+
+        struct ThreadBuffer
+        {
+            uint32_t threadId = 0;
+            std::string name;
+            std::unique_ptr<Sample[]> samples = std::make_unique<Sample[]>(SamplesPerThread);
+            std::atomic<uint64_t> written { 0 };
+        };
+
+        // Buffers are never freed, so samples of finished threads survive
+        // until the trace is written.
+        std::mutex s_registryMutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> s_buffers;
+
+        thread_local ThreadBuffer* t_buffer = nullptr;
+
+        // Reference point used to convert raw timestamps to microseconds.
+        const uint64_t s_startTicks = Profiler::now();
+        const auto s_startTime = std::chrono::steady_clock::now();
+
+        ThreadBuffer& get_thread_buffer()
+        {
+            if (!t_buffer)
+            {
+                std::lock_guard<std::mutex> lock(s_registryMutex);
+                auto buffer = std::make_unique<ThreadBuffer>();
+                buffer->threadId = static_cast<uint32_t>(s_buffers.size());
+                t_buffer = buffer.get();
+                s_buffers.push_back(std::move(buffer));
+            }
+            return *t_buffer;
+        }
+
+        double ticks_per_microsecond()
+        {
+            const uint64_t ticks = Profiler::now() - s_startTicks;
+            const double micros = std::chrono::duration<double, std::micro>(
+                std::chrono::steady_clock::now() - s_startTime).count();
+            return micros > 0.0 ? static_cast<double>(ticks) / micros : 1.0;
+        }
+
+        void write_escaped(std::ofstream& out, const char* str)
+        {
+            for (; *str; ++str)
+            {
+                if (*str == '"' || *str == '\\')
+                {
+                    out << '\\';
+                }
+                out << *str;
+            }
+        }
+    }
+
+    void Profiler::record(const char* name, uint64_t start, uint64_t end)
+    {
+        ThreadBuffer& buffer = get_thread_buffer();
+        const uint64_t index = buffer.written.load(std::memory_order_relaxed);
+        buffer.samples[index & (SamplesPerThread - 1)] = { name, start, end };
+        buffer.written.store(index + 1, std::memory_order_release);
+    }
+
+    void Profiler::set_thread_name(const char* name)
+    {
+        ThreadBuffer& buffer = get_thread_buffer();
+        std::lock_guard<std::mutex> lock(s_registryMutex);
+        buffer.name = name;
+    }
+
+    bool Profiler::write_chrome_trace(const std::string& path)
+    {
+        std::ofstream out(path);
+        if (!out)
+        {
+            LOG_ERROR("ERROR::PROFILER::WRITE_TRACE: {}", path);
+            return false;
+        }
+
+        const double ticksPerUs = ticks_per_microsecond();
+        bool first = true;
+
+        out << std::fixed << std::setprecision(3);
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+        std::lock_guard<std::mutex> lock(s_registryMutex);
+        for (const auto& buffer : s_buffers)
+        {
+            if (!buffer->name.empty())
+            {
+                out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+                    << buffer->threadId << ",\"args\":{\"name\":\"";
+                write_escaped(out, buffer->name.c_str());
+                out << "\"}}";
+                first = false;
+            }
+
+            const uint64_t written = buffer->written.load(std::memory_order_acquire);
+            const uint64_t begin = written > SamplesPerThread ? written - SamplesPerThread : 0;
+
+            for (uint64_t i = begin; i < written; ++i)
+            {
+                const Sample& sample = buffer->samples[i & (SamplesPerThread - 1)];
+                const double ts = static_cast<double>(sample.start - s_startTicks) / ticksPerUs;
+                const double dur = static_cast<double>(sample.end - sample.start) / ticksPerUs;
+
+                out << (first ? "" : ",") << "\n{\"name\":\"";
+                write_escaped(out, sample.name);
+                out << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId
+                    << ",\"ts\":" << ts << ",\"dur\":" << dur << "}";
+                first = false;
+            }
+        }
+
+        out << "\n]}\n";
+
+        LOG_INFO("PROFILER::TRACE_WRITTEN: {}", path);
+        return out.good();
+    }
+
+    void Profiler::clear()
+    {
+        std::lock_guard<std::mutex> lock(s_registryMutex);
+        for (auto& buffer : s_buffers)
+        {
+            buffer->written.store(0, std::memory_order_release);
+        }
+    }
+}
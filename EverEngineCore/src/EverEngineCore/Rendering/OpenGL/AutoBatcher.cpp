@@ -0,0 +1,171 @@
+#include "AutoBatcher.hpp"
+#include "EverEngineCore/Profiler.hpp"
+
+#include <optional>
+
+namespace EverEngine
+{
+    namespace
+    {
+        void point_at(const GeometryBatch& batch, const BatchedMesh& mesh, RenderCommand& command)
+        {
+            command.vao = batch.get_vao();
+            command.bIndexed = true;
+            command.count = mesh.indexCount;
+            command.firstIndex = mesh.firstIndex;
+            command.baseVertex = mesh.baseVertex;
+        }
+    }
+
+    bool AutoBatcher::route(const VertexBuffer& vb, RenderCommand& command)
+    {
+        if (!m_bEnabled || vb.get_vertex_count() == 0)
+        {
+            ++m_stats.unbatched;
+            return false;
+        }
+        if (vb.is_streaming())
+        {
+            return route_dynamic(vb, command);
+        }
+
+        const uint64_t contentId = vb.get_content_id();
+        auto it = m_staticMeshes.find(contentId);
+        CachedMesh* pCached = it != m_staticMeshes.end() ? &it->second : nullptr;
+        if (!pCached)
+        {
+            // Only contents that outlive a flush are worth a permanent copy.
+            if (!m_previousCandidates.contains(contentId))
+            {
+                m_candidates.insert(contentId);
+                return route_dynamic(vb, command);
+            }
+            pCached = &add(m_staticBatches, m_staticMeshes, vb);
+        }
+
+        pCached->lastFlush = m_flush;
+        if (pCached->batch == NotBatched)
+        {
+            ++m_stats.unbatched;
+            return false;
+        }
+        point_at(m_staticBatches[pCached->batch], pCached->mesh, command);
+        ++m_stats.staticMeshes;
+        return true;
+    }
+
+    bool AutoBatcher::route_dynamic(const VertexBuffer& vb, RenderCommand& command)
+    {
+        if (vb.get_vertex_count() > MaxDynamicVertices)
+        {
+            ++m_stats.unbatched;
+            return false;
+        }
+
+        // The same contents drawn again in this flush reuse their copy.
+        auto it = m_dynamicMeshes.find(vb.get_content_id());
+        CachedMesh& cached = it != m_dynamicMeshes.end() ? it->second : add(m_dynamicBatches, m_dynamicMeshes, vb);
+        if (cached.batch == NotBatched)
+        {
+            ++m_stats.unbatched;
+            return false;
+        }
+
+        point_at(m_dynamicBatches[cached.batch], cached.mesh, command);
+        ++m_stats.dynamicMeshes;
+        return true;
+    }
+
+    AutoBatcher::CachedMesh& AutoBatcher::add(std::vector<GeometryBatch>& batches,
+        std::unordered_map<uint64_t, CachedMesh>& meshes, const VertexBuffer& vb)
+    {
+        CachedMesh cached{ NotBatched, {}, static_cast<uint32_t>(vb.get_vertex_count()), m_flush };
+
+        if (const std::optional<VertexLayout> layout = vb.get_layout())
+        {
+            size_t index = 0;
+            while (index < batches.size() && !batches[index].is_compatible(*layout))
+            {
+                ++index;
+            }
+            if (index == batches.size())
+            {
+                batches.emplace_back(*layout);
+            }
+
+            cached.mesh = batches[index].add(vb, *layout);
+            if (cached.mesh)
+            {
+                cached.batch = index;
+            }
+        }
+        return meshes.insert_or_assign(vb.get_content_id(), cached).first->second;
+    }
+
+    void AutoBatcher::end_flush()
+    {
+        for (GeometryBatch& batch : m_dynamicBatches)
+        {
+            batch.clear();
+        }
+        m_dynamicMeshes.clear();
+
+        m_previousCandidates.swap(m_candidates);
+        m_candidates.clear();
+
+        m_lastStats = m_stats;
+        m_stats = {};
+
+        ++m_flush;
+        if (m_flush % EvictionInterval == 0)
+        {
+            evict_static_meshes();
+        }
+    }
+
+    void AutoBatcher::release()
+    {
+        m_staticBatches.clear();
+        m_staticMeshes.clear();
+        m_candidates.clear();
+        m_previousCandidates.clear();
+        m_dynamicBatches.clear();
+        m_dynamicMeshes.clear();
+        m_stats = {};
+        m_lastStats = {};
+    }
+
+    // Batches only grow, so once most of one holds meshes that are no longer
+    // drawn it is emptied; the live meshes are copied back as they are drawn.
+    void AutoBatcher::evict_static_meshes()
+    {
+        PROFILE_SCOPE("AutoBatcher::evict_static_meshes");
+
+        auto is_stale = [this](uint64_t lastFlush) { return m_flush - lastFlush > EvictionInterval; };
+
+        std::vector<size_t> liveVertices(m_staticBatches.size(), 0);
+        for (const auto& [contentId, cached] : m_staticMeshes)
+        {
+            if (cached.batch != NotBatched && !is_stale(cached.lastFlush))
+            {
+                liveVertices[cached.batch] += cached.vertexCount;
+            }
+        }
+
+        std::vector<bool> emptied(m_staticBatches.size(), false);
+        for (size_t i = 0; i < m_staticBatches.size(); ++i)
+        {
+            if (liveVertices[i] * 2 < m_staticBatches[i].get_vertex_count())
+            {
+                m_staticBatches[i].clear();
+                emptied[i] = true;
+            }
+        }
+
+        std::erase_if(m_staticMeshes, [&](const auto& item)
+        {
+            const CachedMesh& cached = item.second;
+            return is_stale(cached.lastFlush) || (cached.batch != NotBatched && emptied[cached.batch]);
+        });
+    }
+}
@@ -0,0 +1,94 @@
+#ifndef AUTO_BATCHER_HPP
+#define AUTO_BATCHER_HPP
+
+#include "GeometryBatch.hpp"
+#include "RenderQueue.hpp"
+#include "VertexBuffer.hpp"
+#include "VertexLayout.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace EverEngine
+{
+    struct AutoBatcherStats
+    {
+        // Draws pointed at a static or a dynamic batch.
+        uint32_t staticMeshes = 0;
+        uint32_t dynamicMeshes = 0;
+        // Draws left on their own VertexBuffer.
+        uint32_t unbatched = 0;
+    };
+
+    // Moves the geometry of queued draws into GeometryBatches shared by every
+    // VertexBuffer with the same layout, so RenderQueue can merge draws that
+    // also share a program and texture into one multi-draw.
+    //
+    // Static batching: a buffer whose contents are drawn unchanged in two
+    // flushes in a row is copied once into a batch kept across frames.
+    // Dynamic batching: small buffers that stream, or changed since the last
+    // flush, are copied into batches that are emptied after every flush.
+    //
+    // Copies are GPU side (glCopyBufferSubData). Buffers whose attributes do
+    // not come from a single interleaved binding are drawn as they are.
+    class AutoBatcher
+    {
+    public:
+        // Larger streamed meshes cost more to copy than a draw call saves.
+        static constexpr size_t MaxDynamicVertices = 1024;
+        // How often static batches are checked for meshes no longer drawn.
+        static constexpr uint32_t EvictionInterval = 120;
+
+        // Points command's geometry (vao, ranges, bIndexed) at a batch.
+        // Returns false when the buffer has to be drawn by itself.
+        bool route(const VertexBuffer& vb, RenderCommand& command);
+        // Call once the flushed commands have been executed.
+        void end_flush();
+        // Frees every batch; call while the GL context is still current.
+        void release();
+        // Counts of the last completed flush.
+        const AutoBatcherStats& get_stats() const { return m_lastStats; }
+
+        void set_enabled(bool bEnabled) { m_bEnabled = bEnabled; }
+        bool is_enabled() const { return m_bEnabled; }
+
+    private:
+        struct CachedMesh
+        {
+            // Index into the batch list; NotBatched when the buffer cannot be.
+            size_t batch;
+            BatchedMesh mesh;
+            uint32_t vertexCount;
+            uint64_t lastFlush;
+        };
+        static constexpr size_t NotBatched = ~size_t(0);
+
+        // Copies vb into the batch for its layout and caches the result
+        // under its content id.
+        CachedMesh& add(std::vector<GeometryBatch>& batches, std::unordered_map<uint64_t, CachedMesh>& meshes,
+            const VertexBuffer& vb);
+        bool route_dynamic(const VertexBuffer& vb, RenderCommand& command);
+        void evict_static_meshes();
+
+        bool m_bEnabled = true;
+        uint64_t m_flush = 0;
+        AutoBatcherStats m_stats;
+        AutoBatcherStats m_lastStats;
+
+        // Meshes are keyed by VertexBuffer::get_content_id.
+        std::vector<GeometryBatch> m_staticBatches;
+        std::unordered_map<uint64_t, CachedMesh> m_staticMeshes;
+        // Contents not yet in a static batch drawn in this and the previous
+        // flush.
+        std::unordered_set<uint64_t> m_candidates;
+        std::unordered_set<uint64_t> m_previousCandidates;
+
+        std::vector<GeometryBatch> m_dynamicBatches;
+        std::unordered_map<uint64_t, CachedMesh> m_dynamicMeshes;
+    };
+}
+
+#endif // AUTO_BATCHER_HPP
@@ -0,0 +1,400 @@
+#include "GeometryBatch.hpp"
+#include "StateCache.hpp"
+#include "EverEngineCore/Log.hpp"
+#include "EverEngineCore/Profiler.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <numeric>
+
+namespace EverEngine
+{
+    namespace
+    {
+        GeometryBatchStats s_stats;
+        GeometryBatchStats s_lastFrameStats;
+
+        std::vector<uint32_t> sequential_indices(size_t count)
+        {
+            std::vector<uint32_t> indices(count);
+            std::iota(indices.begin(), indices.end(), 0u);
+            return indices;
+        }
+    }
+
+    GeometryBatch::GeometryBatch(const VertexLayout& layout, size_t vertexCapacity, size_t indexCapacity)
+        : m_layout(layout)
+        , m_vao(0)
+        , m_vbo(0)
+        , m_ebo(0)
+        , m_vertexCapacity(std::max<size_t>(vertexCapacity, 1))
+        , m_vertexCount(0)
+        , m_indexCapacity(std::max<size_t>(indexCapacity, 1))
+        , m_indexCount(0)
+        , m_indirect(BufferTarget::DrawIndirect, MaxDrawsPerFlush * sizeof(DrawCommand))
+    {
+        if (m_layout.stride <= 0)
+        {
+            LOG_ERROR("ERROR::GEOMETRY_BATCH::EMPTY_LAYOUT");
+        }
+
+        glGenVertexArrays(1, &m_vao);
+        grow(m_vbo, 0, m_vertexCapacity * m_layout.stride);
+        grow(m_ebo, 0, m_indexCapacity * sizeof(uint32_t));
+        setup_vertex_array();
+    }
+
+    GeometryBatch::~GeometryBatch()
+    {
+        destroy();
+    }
+
+    GeometryBatch::GeometryBatch(GeometryBatch&& other) noexcept
+        : m_layout(std::move(other.m_layout))
+        , m_vao(other.m_vao)
+        , m_vbo(other.m_vbo)
+        , m_ebo(other.m_ebo)
+        , m_vertexCapacity(other.m_vertexCapacity)
+        , m_vertexCount(other.m_vertexCount)
+        , m_indexCapacity(other.m_indexCapacity)
+        , m_indexCount(other.m_indexCount)
+        , m_commands(std::move(other.m_commands))
+        , m_indirect(std::move(other.m_indirect))
+    {
+        other.m_vao = 0;
+        other.m_vbo = 0;
+        other.m_ebo = 0;
+        other.m_vertexCount = 0;
+        other.m_indexCount = 0;
+    }
+
+    GeometryBatch& GeometryBatch::operator=(GeometryBatch&& other) noexcept
+    {
+        if (this != &other)
+        {
+            destroy();
+
+            m_layout = std::move(other.m_layout);
+            m_vao = other.m_vao;
+            m_vbo = other.m_vbo;
+            m_ebo = other.m_ebo;
+            m_vertexCapacity = other.m_vertexCapacity;
+            m_vertexCount = other.m_vertexCount;
+            m_indexCapacity = other.m_indexCapacity;
+            m_indexCount = other.m_indexCount;
+            m_commands = std::move(other.m_commands);
+            m_indirect = std::move(other.m_indirect);
+
+            other.m_vao = 0;
+            other.m_vbo = 0;
+            other.m_ebo = 0;
+            other.m_vertexCount = 0;
+            other.m_indexCount = 0;
+        }
+        return *this;
+    }
+
+    void GeometryBatch::destroy()
+    {
+        if (m_vao != 0)
+        {
+            glDeleteVertexArrays(1, &m_vao);
+            StateCache::forget_vertex_array(m_vao);
+        }
+        if (m_vbo != 0)
+        {
+            glDeleteBuffers(1, &m_vbo);
+            StateCache::forget_buffer(m_vbo);
+        }
+        if (m_ebo != 0)
+        {
+            glDeleteBuffers(1, &m_ebo);
+            StateCache::forget_buffer(m_ebo);
+        }
+    }
+
+    // Uploads go through the copy targets: writing through
+    // GL_ELEMENT_ARRAY_BUFFER would rebind whatever VAO is current.
+    void GeometryBatch::grow(GLuint& buffer, size_t usedBytes, size_t newBytes)
+    {
+        GLuint newBuffer = 0;
+        glGenBuffers(1, &newBuffer);
+        StateCache::bind_buffer(GL_COPY_WRITE_BUFFER, newBuffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, newBytes, nullptr, GL_STATIC_DRAW);
+
+        if (buffer != 0)
+        {
+            if (usedBytes > 0)
+            {
+                StateCache::bind_buffer(GL_COPY_READ_BUFFER, buffer);
+                glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, usedBytes);
+            }
+            glDeleteBuffers(1, &buffer);
+            StateCache::forget_buffer(buffer);
+        }
+        buffer = newBuffer;
+    }
+
+    bool GeometryBatch::reserve(size_t vertexCount, size_t indexCount)
+    {
+        // firstIndex and baseVertex are 32-bit in the draw commands.
+        if (m_indexCount + indexCount > std::numeric_limits<uint32_t>::max() ||
+            m_vertexCount + vertexCount > size_t(std::numeric_limits<int32_t>::max()))
+        {
+            LOG_ERROR("ERROR::GEOMETRY_BATCH::FULL: {} vertices, {} indices", m_vertexCount, m_indexCount);
+            return false;
+        }
+
+        bool bGrown = false;
+        if (m_vertexCount + vertexCount > m_vertexCapacity)
+        {
+            const size_t capacity = std::max(m_vertexCapacity * 2, m_vertexCount + vertexCount);
+            grow(m_vbo, m_vertexCount * m_layout.stride, capacity * m_layout.stride);
+            m_vertexCapacity = capacity;
+            bGrown = true;
+        }
+        if (m_indexCount + indexCount > m_indexCapacity)
+        {
+            const size_t capacity = std::max(m_indexCapacity * 2, m_indexCount + indexCount);
+            grow(m_ebo, m_indexCount * sizeof(uint32_t), capacity * sizeof(uint32_t));
+            m_indexCapacity = capacity;
+            bGrown = true;
+        }
+
+        // Attribute pointers hold on to the buffer they were set up with.
+        if (bGrown)
+        {
+            setup_vertex_array();
+        }
+        return true;
+    }
+
+    void GeometryBatch::setup_vertex_array()
+    {
+        StateCache::bind_vertex_array(m_vao);
+        StateCache::bind_buffer(GL_ARRAY_BUFFER, m_vbo);
+        StateCache::bind_buffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
+
+        for (const auto& attrib : m_layout.attributes)
+        {
+            glEnableVertexAttribArray(attrib.index);
+            glVertexAttribPointer(
+                attrib.index, attrib.size, attrib.type,
+                attrib.normalized, m_layout.stride, (void*)size_t(attrib.offset)
+            );
+        }
+
+        StateCache::bind_vertex_array(0);
+    }
+
+    BatchedMesh GeometryBatch::add(const void* vertices, size_t vertexCount,
+        const uint32_t* indices, size_t indexCount)
+    {
+        if (!vertices || vertexCount == 0)
+        {
+            LOG_ERROR("ERROR::GEOMETRY_BATCH::EMPTY_MESH");
+            return {};
+        }
+
+        std::vector<uint32_t> generated;
+        if (!indices || indexCount == 0)
+        {
+            generated = sequential_indices(vertexCount);
+            indices = generated.data();
+            indexCount = generated.size();
+        }
+
+        if (!reserve(vertexCount, indexCount))
+        {
+            return {};
+        }
+
+        const size_t stride = m_layout.stride;
+        StateCache::bind_buffer(GL_COPY_WRITE_BUFFER, m_vbo);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, m_vertexCount * stride, vertexCount * stride, vertices);
+        StateCache::bind_buffer(GL_COPY_WRITE_BUFFER, m_ebo);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, m_indexCount * sizeof(uint32_t), indexCount * sizeof(uint32_t), indices);
+
+        const BatchedMesh mesh{ static_cast<uint32_t>(m_indexCount), static_cast<uint32_t>(indexCount),
+            static_cast<int32_t>(m_vertexCount) };
+        m_vertexCount += vertexCount;
+        m_indexCount += indexCount;
+        return mesh;
+    }
+
+    BatchedMesh GeometryBatch::add(const VertexBuffer& vb, const VertexLayout& layout)
+    {
+        if (!is_compatible(layout))
+        {
+            LOG_ERROR("ERROR::GEOMETRY_BATCH::LAYOUT_MISMATCH");
+            return {};
+        }
+
+        const size_t vertexCount = vb.get_vertex_count();
+        const size_t vertexBytes = vertexCount * m_layout.stride;
+        const GLintptr sourceOffset = GLintptr(vb.get_base_vertex()) * m_layout.stride;
+        if (vb.get_vbo() == 0 || vertexCount == 0)
+        {
+            LOG_ERROR("ERROR::GEOMETRY_BATCH::EMPTY_MESH");
+            return {};
+        }
+
+        GLint64 sourceBytes = 0;
+        StateCache::bind_buffer(GL_COPY_READ_BUFFER, vb.get_vbo());
+        glGetBufferParameteri64v(GL_COPY_READ_BUFFER, GL_BUFFER_SIZE, &sourceBytes);
+        if (sourceBytes < GLint64(sourceOffset + vertexBytes))
+        {
+            LOG_ERROR("ERROR::GEOMETRY_BATCH::SIZE_MISMATCH: buffer has {} bytes, layout needs {}", sourceBytes, sourceOffset + vertexBytes);
+            return {};
+        }
+
+        const size_t indexCount = vb.has_index_buffer() ? vb.get_index_count() : vertexCount;
+        if (!reserve(vertexCount, indexCount))
+        {
+            return {};
+        }
+
+        StateCache::bind_buffer(GL_COPY_READ_BUFFER, vb.get_vbo());
+        StateCache::bind_buffer(GL_COPY_WRITE_BUFFER, m_vbo);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, sourceOffset, m_vertexCount * m_layout.stride, vertexBytes);
+
+        StateCache::bind_buffer(GL_COPY_WRITE_BUFFER, m_ebo);
+        const GLintptr indexOffset = m_indexCount * sizeof(uint32_t);
+        if (vb.has_index_buffer())
+        {
+            StateCache::bind_buffer(GL_COPY_READ_BUFFER, vb.get_ebo());
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, indexOffset, indexCount * sizeof(uint32_t));
+        }
+        else
+        {
+            const std::vector<uint32_t> indices = sequential_indices(indexCount);
+            glBufferSubData(GL_COPY_WRITE_BUFFER, indexOffset, indexCount * sizeof(uint32_t), indices.data());
+        }
+
+        const BatchedMesh mesh{ static_cast<uint32_t>(m_indexCount), static_cast<uint32_t>(indexCount),
+            static_cast<int32_t>(m_vertexCount) };
+        m_vertexCount += vertexCount;
+        m_indexCount += indexCount;
+        return mesh;
+    }
+
+    void GeometryBatch::draw(const BatchedMesh& mesh, uint32_t instanceCount)
+    {
+        if (!mesh || instanceCount == 0)
+        {
+            return;
+        }
+        m_commands.push_back({ mesh.indexCount, instanceCount, mesh.firstIndex, mesh.baseVertex, 0 });
+    }
+
+    void GeometryBatch::flush(DrawMode mode)
+    {
+        if (m_commands.empty())
+        {
+            return;
+        }
+
+        PROFILE_SCOPE("GeometryBatch::flush");
+
+        StateCache::bind_vertex_array(m_vao);
+        const GLenum glMode = static_cast<GLenum>(mode);
+
+        if (has_multi_draw_indirect())
+        {
+            uint32_t baseInstance = 0;
+            for (DrawCommand& command : m_commands)
+            {
+                command.baseInstance = baseInstance;
+                baseInstance += command.instanceCount;
+            }
+
+            // One ring segment per call; more draws than fit take more calls.
+            for (size_t first = 0; first < m_commands.size(); first += MaxDrawsPerFlush)
+            {
+                const size_t count = std::min(MaxDrawsPerFlush, m_commands.size() - first);
+
+                m_indirect.begin_frame();
+                const RingAllocation allocation = m_indirect.allocate(count * sizeof(DrawCommand));
+                if (!allocation)
+                {
+                    break;
+                }
+                std::memcpy(allocation.pData, m_commands.data() + first, count * sizeof(DrawCommand));
+                m_indirect.flush();
+
+                StateCache::bind_buffer(GL_DRAW_INDIRECT_BUFFER, m_indirect.get_id());
+                glMultiDrawElementsIndirect(glMode, GL_UNSIGNED_INT,
+                    reinterpret_cast<const void*>(allocation.offset), static_cast<GLsizei>(count), 0);
+                m_indirect.end_frame();
+                ++s_stats.drawCalls;
+            }
+        }
+        else
+        {
+            flush_fallback(glMode);
+        }
+
+        s_stats.meshes += static_cast<uint32_t>(m_commands.size());
+        m_commands.clear();
+    }
+
+    void GeometryBatch::clear()
+    {
+        m_vertexCount = 0;
+        m_indexCount = 0;
+        m_commands.clear();
+    }
+
+    // Single-instance draws share one glMultiDrawElementsBaseVertex; without
+    // base instance support each instanced draw needs its own call.
+    void GeometryBatch::flush_fallback(GLenum mode)
+    {
+        m_counts.clear();
+        m_offsets.clear();
+        m_baseVertices.clear();
+
+        for (const DrawCommand& command : m_commands)
+        {
+            const void* pOffset = reinterpret_cast<const void*>(size_t(command.firstIndex) * sizeof(uint32_t));
+            if (command.instanceCount == 1)
+            {
+                m_counts.push_back(static_cast<GLsizei>(command.count));
+                m_offsets.push_back(pOffset);
+                m_baseVertices.push_back(command.baseVertex);
+                continue;
+            }
+            glDrawElementsInstancedBaseVertex(mode, static_cast<GLsizei>(command.count), GL_UNSIGNED_INT,
+                pOffset, static_cast<GLsizei>(command.instanceCount), command.baseVertex);
+            ++s_stats.drawCalls;
+        }
+
+        if (!m_counts.empty())
+        {
+            glMultiDrawElementsBaseVertex(mode, m_counts.data(), GL_UNSIGNED_INT, m_offsets.data(),
+                static_cast<GLsizei>(m_counts.size()), m_baseVertices.data());
+            ++s_stats.drawCalls;
+        }
+    }
+
+    bool GeometryBatch::has_multi_draw_indirect()
+    {
+        return glMultiDrawElementsIndirect != nullptr;
+    }
+
+    const GeometryBatchStats& GeometryBatch::get_stats()
+    {
+        return s_stats;
+    }
+
+    const GeometryBatchStats& GeometryBatch::get_last_frame_stats()
+    {
+        return s_lastFrameStats;
+    }
+
+    void GeometryBatch::end_frame()
+    {
+        s_lastFrameStats = s_stats;
+        s_stats = {};
+    }
+}
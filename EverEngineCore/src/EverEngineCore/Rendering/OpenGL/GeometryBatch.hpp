@@ -0,0 +1,131 @@
+#ifndef GEOMETRY_BATCH_HPP
+#define GEOMETRY_BATCH_HPP
+
+#include "RingBuffer.hpp"
+#include "VertexBuffer.hpp"
+#include "VertexLayout.hpp"
+
+#include <glad/glad.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace EverEngine
+{
+    // A mesh's place inside a batch's shared buffers.
+    struct BatchedMesh
+    {
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;
+        int32_t baseVertex = 0;
+
+        explicit operator bool() const { return indexCount != 0; }
+    };
+
+    struct GeometryBatchStats
+    {
+        // Meshes drawn through batches.
+        uint32_t meshes = 0;
+        // GL draw calls issued for them.
+        uint32_t drawCalls = 0;
+
+        uint32_t get_saved() const { return meshes - drawCalls; }
+    };
+
+    // Shared vertex and index buffers for meshes with one VertexLayout. Meshes
+    // are appended once (static batching); each frame the ones to render are
+    // queued with draw() and flush() issues them all with a single
+    // glMultiDrawElementsIndirect (GL 4.3), falling back to
+    // glMultiDrawElementsBaseVertex (GL 3.2).
+    //
+    // With the indirect path, draw i gets baseInstance = the number of
+    // instances queued before it, so per-draw data can be fetched from an
+    // instanced attribute or gl_BaseInstance.
+    //
+    //     GeometryBatch batch(layout);
+    //     BatchedMesh rock = batch.add(rockVb, layout);
+    //     ...
+    //     batch.draw(rock);
+    //     batch.flush();
+    class GeometryBatch
+    {
+    public:
+        static constexpr size_t MaxDrawsPerFlush = 16384;
+
+        explicit GeometryBatch(const VertexLayout& layout,
+            size_t vertexCapacity = 65536, size_t indexCapacity = 196608);
+        ~GeometryBatch();
+
+        GeometryBatch(const GeometryBatch&) = delete;
+        GeometryBatch& operator=(const GeometryBatch&) = delete;
+
+        GeometryBatch(GeometryBatch&& other) noexcept;
+        GeometryBatch& operator=(GeometryBatch&& other) noexcept;
+
+        // Appends a mesh; vertices are in the batch's layout. Without indices
+        // the vertices are drawn in order. Returns an empty mesh on failure.
+        BatchedMesh add(const void* vertices, size_t vertexCount,
+            const uint32_t* indices = nullptr, size_t indexCount = 0);
+        // Copies an existing VertexBuffer on the GPU; layout is the one its
+        // attributes were set up with and must match the batch's.
+        BatchedMesh add(const VertexBuffer& vb, const VertexLayout& layout);
+
+        // Queues a mesh for the next flush().
+        void draw(const BatchedMesh& mesh, uint32_t instanceCount = 1);
+        // Issues everything queued with the program currently in use.
+        void flush(DrawMode mode = DrawMode::Triangles);
+        // Drops every mesh but keeps the buffers, for batches refilled each
+        // frame (dynamic batching).
+        void clear();
+
+        bool is_compatible(const VertexLayout& layout) const { return layout == m_layout; }
+        GLuint get_vao() const { return m_vao; }
+        size_t get_vertex_count() const { return m_vertexCount; }
+        size_t get_index_count() const { return m_indexCount; }
+        size_t get_queued_count() const { return m_commands.size(); }
+
+        static bool has_multi_draw_indirect();
+
+        // Totals over every batch for the frame in progress and the last
+        // finished one.
+        static const GeometryBatchStats& get_stats();
+        static const GeometryBatchStats& get_last_frame_stats();
+        static void end_frame();
+
+    private:
+        // Matches the GL DrawElementsIndirectCommand layout.
+        struct DrawCommand
+        {
+            uint32_t count;
+            uint32_t instanceCount;
+            uint32_t firstIndex;
+            int32_t baseVertex;
+            uint32_t baseInstance;
+        };
+
+        bool reserve(size_t vertexCount, size_t indexCount);
+        void grow(GLuint& buffer, size_t usedBytes, size_t newBytes);
+        void setup_vertex_array();
+        void flush_fallback(GLenum mode);
+        void destroy();
+
+        VertexLayout m_layout;
+        GLuint m_vao;
+        GLuint m_vbo;
+        GLuint m_ebo;
+        size_t m_vertexCapacity;
+        size_t m_vertexCount;
+        size_t m_indexCapacity;
+        size_t m_indexCount;
+
+        std::vector<DrawCommand> m_commands;
+        RingBuffer m_indirect;
+
+        // Scratch for the fallback path.
+        std::vector<GLsizei> m_counts;
+        std::vector<const void*> m_offsets;
+        std::vector<GLint> m_baseVertices;
+    };
+}
+
+#endif // GEOMETRY_BATCH_HPP
@@ -0,0 +1,223 @@
+#include "RenderQueue.hpp"
+#include "StateCache.hpp"
+#include "EverEngineCore/Profiler.hpp"
+
+#include <algorithm>
+
+namespace EverEngine
+{
+    uint64_t RenderQueue::make_sort_key(uint8_t layer, uint32_t program, uint32_t material, float depth)
+    {
+        const float clamped = std::clamp(depth, 0.0f, 1.0f);
+        const uint64_t quantized = static_cast<uint64_t>(clamped * float(0xFFFFFF));
+
+        return (uint64_t(layer) << 56)
+            | (uint64_t(program & 0xFFFF) << 40)
+            | (uint64_t(material & 0xFFFF) << 24)
+            | quantized;
+    }
+
+    void RenderQueue::submit(const RenderCommand& command)
+    {
+        m_commands.push_back(command);
+    }
+
+    void RenderQueue::flush()
+    {
+        PROFILE_SCOPE("RenderQueue::flush");
+
+        sort();
+        execute();
+        clear();
+    }
+
+    void RenderQueue::sort()
+    {
+        PROFILE_SCOPE("RenderQueue::sort");
+
+        const size_t count = m_commands.size();
+        m_order.resize(count);
+        m_scratch.resize(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            m_order[i] = { m_commands[i].sortKey, static_cast<uint32_t>(i) };
+        }
+
+        // LSD radix sort, one byte per pass. All histograms come from one
+        // read of the keys, and a byte that is equal across every key (e.g.
+        // a single layer) skips its pass entirely.
+        uint32_t histograms[8][256] = {};
+        for (const SortEntry& entry : m_order)
+        {
+            for (int pass = 0; pass < 8; ++pass)
+            {
+                ++histograms[pass][(entry.key >> (pass * 8)) & 0xFF];
+            }
+        }
+
+        for (int pass = 0; pass < 8; ++pass)
+        {
+            uint32_t* histogram = histograms[pass];
+            const uint64_t firstByte = count > 0 ? (m_order[0].key >> (pass * 8)) & 0xFF : 0;
+            if (histogram[firstByte] == count)
+            {
+                continue;
+            }
+
+            uint32_t offset = 0;
+            for (int bucket = 0; bucket < 256; ++bucket)
+            {
+                const uint32_t bucketCount = histogram[bucket];
+                histogram[bucket] = offset;
+                offset += bucketCount;
+            }
+
+            for (const SortEntry& entry : m_order)
+            {
+                m_scratch[histogram[(entry.key >> (pass * 8)) & 0xFF]++] = entry;
+            }
+            m_order.swap(m_scratch);
+        }
+    }
+
+    namespace
+    {
+        bool can_merge(const RenderCommand& first, const RenderCommand& next)
+        {
+            return next.program == first.program && next.vao == first.vao && next.texture == first.texture &&
+                next.mode == first.mode && next.bIndexed == first.bIndexed &&
+                next.instanceCount == 1 && next.constantsBuffer == 0;
+        }
+
+        const void* get_index_offset(const RenderCommand& command)
+        {
+            return reinterpret_cast<const void*>(size_t(command.firstIndex) * sizeof(GLuint));
+        }
+    }
+
+    void RenderQueue::execute()
+    {
+        PROFILE_SCOPE("RenderQueue::execute");
+
+        m_stats = {};
+
+        // Ids that can never match, so the first command counts as a change.
+        GLuint program = ~0u;
+        GLuint vao = ~0u;
+        GLuint texture = ~0u;
+
+        for (size_t i = 0; i < m_order.size();)
+        {
+            const RenderCommand& command = m_commands[m_order[i].index];
+
+            if (command.program != program)
+            {
+                StateCache::use_program(command.program);
+                program = command.program;
+                ++m_stats.programChanges;
+            }
+            if (command.vao != vao)
+            {
+                StateCache::bind_vertex_array(command.vao);
+                vao = command.vao;
+                ++m_stats.vertexArrayChanges;
+            }
+            if (command.texture != 0 && command.texture != texture)
+            {
+                StateCache::bind_texture(0, GL_TEXTURE_2D, command.texture);
+                texture = command.texture;
+                ++m_stats.textureChanges;
+            }
+            if (command.constantsBuffer != 0)
+            {
+                StateCache::bind_buffer_range(GL_UNIFORM_BUFFER, DrawConstantsBinding,
+                    command.constantsBuffer, command.constantsOffset, command.constantsSize);
+            }
+
+            size_t end = i + 1;
+            if (command.instanceCount == 1 && command.constantsBuffer == 0)
+            {
+                while (end < m_order.size() && can_merge(command, m_commands[m_order[end].index]))
+                {
+                    ++end;
+                }
+            }
+
+            if (end - i > 1)
+            {
+                execute_merged(i, end);
+            }
+            else
+            {
+                execute_single(command);
+            }
+            m_stats.draws += static_cast<uint32_t>(end - i);
+            ++m_stats.drawCalls;
+            i = end;
+        }
+    }
+
+    void RenderQueue::execute_single(const RenderCommand& command)
+    {
+        const GLsizei count = static_cast<GLsizei>(command.count);
+        if (command.bIndexed)
+        {
+            if (command.instanceCount > 1)
+            {
+                glDrawElementsInstancedBaseVertex(command.mode, count, GL_UNSIGNED_INT, get_index_offset(command),
+                    command.instanceCount, command.baseVertex);
+            }
+            else
+            {
+                glDrawElementsBaseVertex(command.mode, count, GL_UNSIGNED_INT, get_index_offset(command), command.baseVertex);
+            }
+        }
+        else
+        {
+            if (command.instanceCount > 1)
+            {
+                glDrawArraysInstanced(command.mode, command.baseVertex, count, command.instanceCount);
+            }
+            else
+            {
+                glDrawArrays(command.mode, command.baseVertex, count);
+            }
+        }
+    }
+
+    void RenderQueue::execute_merged(size_t first, size_t end)
+    {
+        m_counts.clear();
+        m_offsets.clear();
+        m_firsts.clear();
+
+        const RenderCommand& head = m_commands[m_order[first].index];
+        for (size_t i = first; i < end; ++i)
+        {
+            const RenderCommand& command = m_commands[m_order[i].index];
+            m_counts.push_back(static_cast<GLsizei>(command.count));
+            m_firsts.push_back(command.baseVertex);
+            if (head.bIndexed)
+            {
+                m_offsets.push_back(get_index_offset(command));
+            }
+        }
+
+        const GLsizei drawCount = static_cast<GLsizei>(m_counts.size());
+        if (head.bIndexed)
+        {
+            glMultiDrawElementsBaseVertex(head.mode, m_counts.data(), GL_UNSIGNED_INT, m_offsets.data(),
+                drawCount, m_firsts.data());
+        }
+        else
+        {
+            glMultiDrawArrays(head.mode, m_firsts.data(), m_counts.data(), drawCount);
+        }
+    }
+
+    void RenderQueue::clear()
+    {
+        m_commands.clear();
+        m_order.clear();
+    }
+}
@@ -0,0 +1,105 @@
+#ifndef RENDER_QUEUE_HPP
+#define RENDER_QUEUE_HPP
+
+#include <glad/glad.h>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace EverEngine
+{
+    // One deferred draw. Plain data, so submitting is a copy into a vector.
+    struct RenderCommand
+    {
+        uint64_t sortKey;
+
+        GLuint program;
+        GLuint vao;
+        // Bound to unit 0 as GL_TEXTURE_2D; 0 leaves the unit alone.
+        GLuint texture;
+
+        // Per-draw constants, bound with glBindBufferRange to
+        // RenderQueue::DrawConstantsBinding; buffer 0 for none.
+        GLuint constantsBuffer;
+        uint32_t constantsOffset;
+        uint32_t constantsSize;
+
+        GLenum mode;
+        // Index count when bIndexed, vertex count otherwise.
+        uint32_t count;
+        // First index to read when bIndexed.
+        uint32_t firstIndex;
+        uint32_t instanceCount;
+        // Added to each index, or the first vertex when not indexed
+        // (VertexBuffer::get_base_vertex for streamed buffers).
+        int32_t baseVertex;
+        bool bIndexed;
+    };
+    static_assert(std::is_trivially_copyable_v<RenderCommand>);
+
+    struct RenderQueueStats
+    {
+        uint32_t draws = 0;
+        // GL draw calls issued for them.
+        uint32_t drawCalls = 0;
+        uint32_t programChanges = 0;
+        uint32_t vertexArrayChanges = 0;
+        uint32_t textureChanges = 0;
+    };
+
+    // Collects a frame's draws, radix-sorts them by key and executes them in
+    // that order, so draws sharing a program, VAO and texture run together.
+    // Consecutive single-instance draws that differ only in their range of
+    // the VAO's buffers (e.g. meshes of one GeometryBatch) are issued with one
+    // glMultiDrawElementsBaseVertex or glMultiDrawArrays.
+    class RenderQueue
+    {
+    public:
+        static constexpr GLuint DrawConstantsBinding = 1;
+
+        // Most significant first:
+        //   layer    8 bits  (opaque before transparent, UI last, ...)
+        //   program 16 bits
+        //   material 16 bits (texture or material id)
+        //   depth   24 bits  (0 near .. 1 far; flip for back to front)
+        // Truncated ids only affect ordering, never what gets drawn.
+        static uint64_t make_sort_key(uint8_t layer, uint32_t program, uint32_t material, float depth);
+
+        void submit(const RenderCommand& command);
+
+        // Sorts and executes everything submitted since the last flush.
+        void flush();
+
+        size_t get_count() const { return m_commands.size(); }
+        const RenderQueueStats& get_stats() const { return m_stats; }
+
+        // The steps of flush(), in order.
+        void sort();
+        void execute();
+        void clear();
+
+    private:
+        void execute_single(const RenderCommand& command);
+        // Issues the commands at m_order[first, end) with one call.
+        void execute_merged(size_t first, size_t end);
+
+        struct SortEntry
+        {
+            uint64_t key;
+            uint32_t index;
+        };
+
+        std::vector<RenderCommand> m_commands;
+        std::vector<SortEntry> m_order;
+        std::vector<SortEntry> m_scratch;
+        RenderQueueStats m_stats;
+
+        // Scratch for merged draws.
+        std::vector<GLsizei> m_counts;
+        std::vector<const void*> m_offsets;
+        std::vector<GLint> m_firsts;
+    };
+}
+
+#endif // RENDER_QUEUE_HPP
@@ -2,10 +2,15 @@
 #include <GLFW/glfw3.h>
 
 #include "RendererOpenGL.hpp"
+#include "StateCache.hpp"
+#include "Shader.hpp"
 #include "EverEngineCore/Log.hpp"
 
 namespace EverEngine
 {
+    static RenderQueue s_queue;
+    static AutoBatcher s_batcher;
+
     bool Renderer_OpenGL::init(GLFWwindow* pWindow)
     {
         if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
@@ -16,9 +21,55 @@ namespace EverEngine
         return true;
     }
 
-    void Renderer_OpenGL::draw(const VertexBuffer& vb)
+    void Renderer_OpenGL::shutdown()
+    {
+        s_queue.clear();
+        s_batcher.release();
+    }
+
+    void Renderer_OpenGL::draw(const VertexBuffer& vb, const Shader& shader, GLuint texture,
+        uint8_t layer, float depth, DrawMode mode)
+    {
+        RenderCommand command = {};
+        command.program = shader.get_program();
+        command.texture = texture;
+        command.mode = static_cast<GLenum>(mode);
+        command.instanceCount = 1;
+        if (!s_batcher.route(vb, command))
+        {
+            command.vao = vb.get_vao();
+            command.bIndexed = vb.has_index_buffer();
+            command.count = static_cast<uint32_t>(command.bIndexed ? vb.get_index_count() : vb.get_vertex_count());
+            command.baseVertex = vb.get_base_vertex();
+        }
+        command.sortKey = RenderQueue::make_sort_key(layer, command.program, texture, depth);
+        s_queue.submit(command);
+    }
+
+    void Renderer_OpenGL::submit(const RenderCommand& command)
+    {
+        s_queue.submit(command);
+    }
+
+    void Renderer_OpenGL::flush()
+    {
+        s_queue.flush();
+        s_batcher.end_flush();
+    }
+
+    const RenderQueueStats& Renderer_OpenGL::get_queue_stats()
     {
+        return s_queue.get_stats();
+    }
 
+    const AutoBatcherStats& Renderer_OpenGL::get_batcher_stats()
+    {
+        return s_batcher.get_stats();
+    }
+
+    void Renderer_OpenGL::set_batching(bool bEnabled)
+    {
+        s_batcher.set_enabled(bEnabled);
     }
 
     void Renderer_OpenGL::set_clear_color(const float r, const float g, const float b, const float a)
@@ -34,23 +85,34 @@ namespace EverEngine
     void Renderer_OpenGL::set_viewport(
         const unsigned int width, 
         const unsigned int height, 
-        const unsigned int left_offset = 0,
-        const unsigned int down_offset = 0)
+        const unsigned int left_offset,
+        const unsigned int down_offset)
     {
-        glViewport(left_offset, down_offset, width, height);
+        StateCache::set_viewport(left_offset, down_offset, width, height);
     }
     
     void Renderer_OpenGL::enable_depth_test()
     {
-        glEnable(GL_DEPTH_TEST);
+        StateCache::set_enabled(GL_DEPTH_TEST, true);
     }
 
     void Renderer_OpenGL::disable_depth_test()
     {
-        glDisable(GL_DEPTH_TEST);
+        StateCache::set_enabled(GL_DEPTH_TEST, false);
+    }
+
+    const char* Renderer_OpenGL::get_vendor_str()
+    {
+        return reinterpret_cast<const char*>(glGetString(GL_VENDOR));
     }
 
-    const char* get_vendor_str() {};
-    const char* get_renderer_str() {};
-    const char* get_version_str() {};
+    const char* Renderer_OpenGL::get_renderer_str()
+    {
+        return reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+    }
+
+    const char* Renderer_OpenGL::get_version_str()
+    {
+        return reinterpret_cast<const char*>(glGetString(GL_VERSION));
+    }
 }
\ No newline at end of file
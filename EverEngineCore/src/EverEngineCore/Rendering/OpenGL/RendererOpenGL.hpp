@@ -1,18 +1,39 @@
 #ifndef RENDERER_OPENGL_HPP
 #define RENDERER_OPENGL_HPP
 
+#include "AutoBatcher.hpp"
+#include "RenderQueue.hpp"
+#include "VertexBuffer.hpp"
+
+#include <cstdint>
+
 struct GLFWwindow;
 
 namespace EverEngine
 {
-    class VertexBuffer;
-    class VertexLayout;
+    class Shader;
 
     class Renderer_OpenGL {
     public:
         static bool init(GLFWwindow* pWindow);
+        // Releases the GL objects kept across frames. Call before the
+        // context is destroyed.
+        static void shutdown();
+
+        // Queues a draw; nothing reaches GL until flush(). texture is bound
+        // to unit 0 (0 leaves it alone) and draws are grouped by it. Unless
+        // batching is off, the geometry is drawn from a shared batch (see
+        // AutoBatcher) so draws with the same shader, texture and layout
+        // become one GL call.
+        static void draw(const VertexBuffer& vb, const Shader& shader, GLuint texture = 0,
+            uint8_t layer = 0, float depth = 0.0f, DrawMode mode = DrawMode::Triangles);
+        static void submit(const RenderCommand& command);
+        // Sorts and executes the frame's draws.
+        static void flush();
+        static const RenderQueueStats& get_queue_stats();
+        static const AutoBatcherStats& get_batcher_stats();
+        static void set_batching(bool bEnabled);
 
-        static void draw(const VertexBuffer& vb);
         static void set_clear_color(const float r, const float g, const float b, const float a);
         static void clear();
         static void set_viewport(
@@ -0,0 +1,243 @@
+#include "RingBuffer.hpp"
+#include "StateCache.hpp"
+#include "EverEngineCore/Log.hpp"
+#include "EverEngineCore/Profiler.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace EverEngine
+{
+    RingBuffer::RingBuffer(BufferTarget target, size_t frameSize)
+        : m_id(0)
+        , m_target(target)
+        , m_frameSize(0)
+        , m_alignment(get_buffer_offset_alignment(target))
+        , m_pMapped(nullptr)
+        , m_uploaded(0)
+        , m_fences{}
+        , m_segment(0)
+        , m_head(0)
+        , m_bFull(false)
+    {
+        // Every segment starts aligned, so offsets inside stay aligned.
+        m_frameSize = (frameSize + m_alignment - 1) / m_alignment * m_alignment;
+        const size_t totalSize = m_frameSize * FramesInFlight;
+        // Set up through the copy target: binding GL_ELEMENT_ARRAY_BUFFER
+        // would replace the index buffer of whatever VAO is bound.
+        const GLenum glTarget = GL_COPY_WRITE_BUFFER;
+
+        glGenBuffers(1, &m_id);
+        StateCache::bind_buffer(glTarget, m_id);
+
+        if (glBufferStorage)
+        {
+            const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            glBufferStorage(glTarget, totalSize, nullptr, flags);
+            m_pMapped = static_cast<uint8_t*>(glMapBufferRange(glTarget, 0, totalSize, flags));
+            if (!m_pMapped)
+            {
+                LOG_ERROR("ERROR::RING_BUFFER::MAP_FAILED, falling back to staged uploads");
+                glDeleteBuffers(1, &m_id);
+                StateCache::forget_buffer(m_id);
+                glGenBuffers(1, &m_id);
+                StateCache::bind_buffer(glTarget, m_id);
+            }
+        }
+
+        if (!m_pMapped)
+        {
+            glBufferData(glTarget, totalSize, nullptr, GL_STREAM_DRAW);
+            m_staging.resize(totalSize);
+        }
+    }
+
+    RingBuffer::~RingBuffer()
+    {
+        destroy();
+    }
+
+    RingBuffer::RingBuffer(RingBuffer&& other) noexcept
+        : m_id(other.m_id)
+        , m_target(other.m_target)
+        , m_frameSize(other.m_frameSize)
+        , m_alignment(other.m_alignment)
+        , m_pMapped(other.m_pMapped)
+        , m_staging(std::move(other.m_staging))
+        , m_uploaded(other.m_uploaded)
+        , m_segment(other.m_segment)
+        , m_head(other.m_head)
+        , m_bFull(other.m_bFull)
+    {
+        std::copy(std::begin(other.m_fences), std::end(other.m_fences), m_fences);
+        std::fill(std::begin(other.m_fences), std::end(other.m_fences), nullptr);
+        other.m_id = 0;
+        other.m_pMapped = nullptr;
+    }
+
+    RingBuffer& RingBuffer::operator=(RingBuffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            destroy();
+
+            m_id = other.m_id;
+            m_target = other.m_target;
+            m_frameSize = other.m_frameSize;
+            m_alignment = other.m_alignment;
+            m_pMapped = other.m_pMapped;
+            m_staging = std::move(other.m_staging);
+            m_uploaded = other.m_uploaded;
+            m_segment = other.m_segment;
+            m_head = other.m_head;
+            m_bFull = other.m_bFull;
+            std::copy(std::begin(other.m_fences), std::end(other.m_fences), m_fences);
+
+            std::fill(std::begin(other.m_fences), std::end(other.m_fences), nullptr);
+            other.m_id = 0;
+            other.m_pMapped = nullptr;
+        }
+        return *this;
+    }
+
+    void RingBuffer::destroy()
+    {
+        for (GLsync& fence : m_fences)
+        {
+            if (fence)
+            {
+                glDeleteSync(fence);
+                fence = nullptr;
+            }
+        }
+        if (m_id != 0)
+        {
+            // Deleting a buffer unmaps it.
+            glDeleteBuffers(1, &m_id);
+            StateCache::forget_buffer(m_id);
+            m_id = 0;
+        }
+        m_pMapped = nullptr;
+    }
+
+    void RingBuffer::begin_frame()
+    {
+        PROFILE_SCOPE("RingBuffer::begin_frame");
+
+        m_segment = (m_segment + 1) % FramesInFlight;
+        m_head = m_segment * m_frameSize;
+        m_uploaded = m_head;
+        m_bFull = false;
+
+        GLsync& fence = m_fences[m_segment];
+        if (!fence)
+        {
+            return;
+        }
+
+        // Normally already signalled; only a GPU more than FramesInFlight
+        // frames behind makes this block.
+        GLenum result = glClientWaitSync(fence, 0, 0);
+        while (result == GL_TIMEOUT_EXPIRED)
+        {
+            result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+        }
+        if (result == GL_WAIT_FAILED)
+        {
+            LOG_ERROR("ERROR::RING_BUFFER::FENCE_WAIT_FAILED");
+        }
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    void RingBuffer::end_frame()
+    {
+        GLsync& fence = m_fences[m_segment];
+        if (fence)
+        {
+            glDeleteSync(fence);
+        }
+        fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    RingAllocation RingBuffer::allocate(size_t size, size_t alignment)
+    {
+        if (alignment == 0)
+        {
+            alignment = m_alignment;
+        }
+
+        const size_t offset = (m_head + alignment - 1) / alignment * alignment;
+        const size_t segmentEnd = (m_segment + 1) * m_frameSize;
+        if (size == 0 || offset + size > segmentEnd)
+        {
+            if (size != 0 && !m_bFull)
+            {
+                LOG_ERROR("ERROR::RING_BUFFER::FRAME_FULL: {} bytes requested, frame size {}", size, m_frameSize);
+                m_bFull = true;
+            }
+            return {};
+        }
+        m_head = offset + size;
+
+        uint8_t* pBase = m_pMapped ? m_pMapped : m_staging.data();
+        return { pBase + offset, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size) };
+    }
+
+    bool RingBuffer::can_allocate(size_t size, size_t alignment) const
+    {
+        if (alignment == 0)
+        {
+            alignment = m_alignment;
+        }
+        const size_t offset = (m_head + alignment - 1) / alignment * alignment;
+        return size != 0 && offset + size <= (m_segment + 1) * m_frameSize;
+    }
+
+    size_t RingBuffer::get_aligned_size(size_t size) const
+    {
+        return (size + m_alignment - 1) / m_alignment * m_alignment;
+    }
+
+    void RingBuffer::flush() const
+    {
+        if (m_pMapped || m_uploaded >= m_head)
+        {
+            return;
+        }
+        StateCache::bind_buffer(GL_COPY_WRITE_BUFFER, m_id);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, m_uploaded, m_head - m_uploaded, m_staging.data() + m_uploaded);
+        m_uploaded = m_head;
+    }
+
+    void RingBuffer::update(GLintptr offset, const void* data, size_t size)
+    {
+        if (offset < 0 || offset + size > m_frameSize * FramesInFlight)
+        {
+            LOG_ERROR("ERROR::RING_BUFFER::UPDATE_OUT_OF_RANGE: {} bytes at {}, buffer has {}",
+                size, offset, m_frameSize * FramesInFlight);
+            return;
+        }
+
+        if (m_pMapped)
+        {
+            std::memcpy(m_pMapped + offset, data, size);
+            return;
+        }
+        // The staged copy may already have been uploaded; send the change now.
+        std::memcpy(m_staging.data() + offset, data, size);
+        StateCache::bind_buffer(GL_COPY_WRITE_BUFFER, m_id);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, m_staging.data() + offset);
+    }
+
+    void RingBuffer::bind_range(GLuint binding, const RingAllocation& allocation) const
+    {
+        bind_range(binding, allocation.offset, allocation.size);
+    }
+
+    void RingBuffer::bind_range(GLuint binding, GLintptr offset, GLsizeiptr size) const
+    {
+        flush();
+        StateCache::bind_buffer_range(static_cast<GLenum>(m_target), binding, m_id, offset, size);
+    }
+}
@@ -0,0 +1,113 @@
+#ifndef RING_BUFFER_HPP
+#define RING_BUFFER_HPP
+
+#include "ShaderBuffer.hpp"
+
+#include <glad/glad.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace EverEngine
+{
+    struct RingAllocation
+    {
+        // Write-only; null when the frame's segment is full.
+        void* pData = nullptr;
+        GLintptr offset = 0;
+        GLsizeiptr size = 0;
+
+        explicit operator bool() const { return pData != nullptr; }
+    };
+
+    // Per-frame upload buffer split into one segment per frame in flight.
+    // Uses a persistently mapped buffer (GL 4.4 / ARB_buffer_storage) so an
+    // allocation is a pointer bump and the upload is the caller's memcpy;
+    // a fence per segment keeps the CPU from overwriting data the GPU is
+    // still reading. Older contexts stage in memory and upload on bind.
+    //
+    //     ring.begin_frame();
+    //     RingAllocation a = ring.push(objectConstants);
+    //     ring.bind_range(1, a);
+    //     ... draw ...
+    //     ring.end_frame();
+    class RingBuffer
+    {
+    public:
+        static constexpr uint32_t FramesInFlight = 3;
+
+        RingBuffer(BufferTarget target, size_t frameSize);
+        ~RingBuffer();
+
+        RingBuffer(const RingBuffer&) = delete;
+        RingBuffer& operator=(const RingBuffer&) = delete;
+
+        RingBuffer(RingBuffer&& other) noexcept;
+        RingBuffer& operator=(RingBuffer&& other) noexcept;
+
+        // Waits until the GPU has finished with the segment being reused.
+        void begin_frame();
+        // Fences the frame's commands; call after its last draw.
+        void end_frame();
+
+        // alignment 0 uses the target's binding alignment, so the result can
+        // go straight to bind_range.
+        RingAllocation allocate(size_t size, size_t alignment = 0);
+        // Whether allocate would succeed, without logging when it would not.
+        bool can_allocate(size_t size, size_t alignment = 0) const;
+
+        template<typename T>
+        RingAllocation push(const T& value)
+        {
+            RingAllocation allocation = allocate(sizeof(T));
+            if (allocation)
+            {
+                std::memcpy(allocation.pData, &value, sizeof(T));
+            }
+            return allocation;
+        }
+
+        // Rounds size up so consecutive elements of one allocation can each
+        // be bound with bind_range.
+        size_t get_aligned_size(size_t size) const;
+
+        void bind_range(GLuint binding, const RingAllocation& allocation) const;
+        void bind_range(GLuint binding, GLintptr offset, GLsizeiptr size) const;
+
+        // Uploads staged writes; a no-op when persistent. bind_range does
+        // this itself, other uses (vertex or indirect source) must call it
+        // before drawing.
+        void flush() const;
+
+        // Rewrites bytes of an earlier allocation in place; offset is from the
+        // start of the buffer. Only safe while no command that reads them has
+        // been issued.
+        void update(GLintptr offset, const void* data, size_t size);
+
+        GLuint get_id() const { return m_id; }
+        BufferTarget get_target() const { return m_target; }
+        size_t get_frame_size() const { return m_frameSize; }
+        bool is_persistent() const { return m_pMapped != nullptr; }
+
+    private:
+        void destroy();
+
+        GLuint m_id;
+        BufferTarget m_target;
+        size_t m_frameSize;
+        size_t m_alignment;
+
+        uint8_t* m_pMapped;
+        // Fallback when buffer storage is unavailable.
+        mutable std::vector<uint8_t> m_staging;
+        mutable size_t m_uploaded;
+
+        GLsync m_fences[FramesInFlight];
+        uint32_t m_segment;
+        size_t m_head;
+        bool m_bFull;
+    };
+}
+
+#endif // RING_BUFFER_HPP
@@ -1,127 +1,354 @@
 #include "Shader.hpp"
 #include "EverEngineCore/Log.hpp"
+#include "EverEngineCore/Profiler.hpp"
 
 #include <fstream>
 #include <sstream>
 #include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include "ShaderCache.hpp"
+#include "StateCache.hpp"
 #include "../../Platform/Generic/FileSystem.hpp" 
 
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
 namespace EverEngine
 {
-    Shader::Shader(const std::unordered_map<GLenum, const char*>& sources)
-        : m_id(0)
+    namespace
     {
-        m_id = glCreateProgram();
-        std::vector<GLuint> shaderIDs;
+        // Shaders built from files, so a changed file can find its programs.
+        // Only touched on the GL thread.
+        std::vector<Shader*> s_fileShaders;
 
-        for (const auto& [type, path] : sources)
+        // Not in the generated loader, so looked up by init_parallel_compile.
+        typedef void (APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSPROC)(GLuint count);
+        PFNGLMAXSHADERCOMPILERTHREADSPROC s_maxCompilerThreads = nullptr;
+        bool s_bParallelCompile = false;
+
+        void untrack(Shader* pShader)
+        {
+            s_fileShaders.erase(std::remove(s_fileShaders.begin(), s_fileShaders.end(), pShader), s_fileShaders.end());
+        }
+
+        const char* stage_name(GLenum type)
         {
-            // Використовуємо FileSystem замість власного load_file
-            if (!FileSystem::File::Exists(path))
+            switch (type)
             {
-                LOG_ERROR("ERROR::SHADER::FILE_NOT_FOUND: {}", path);
-                continue;
+                case GL_VERTEX_SHADER:   return "VERTEX";
+                case GL_FRAGMENT_SHADER: return "FRAGMENT";
+                case GL_GEOMETRY_SHADER: return "GEOMETRY";
+                case GL_COMPUTE_SHADER: return "COMPUTE";
+                case GL_TESS_EVALUATION_SHADER: return "TESS_EVALUATION";
+                case GL_TESS_CONTROL_SHADER: return "TESS_CONTROL";
+
+        #ifdef GL_MESH_SHADER_NV
+                case GL_MESH_SHADER_NV: return "MESH";
+        #endif
+        #ifdef GL_TASK_SHADER_NV
+                case GL_TASK_SHADER_NV: return "TASK";
+        #endif
+
+                default: return "UNKNOWN";
             }
+        }
+    }
+
+    Shader::Shader(const std::unordered_map<GLenum, const char*>& sources, ShaderBuild build)
+        : m_id(0)
+    {
+        PROFILE_SCOPE("Shader::Shader");
 
-            std::string code = FileSystem::File::ReadText(path);
-            if (code.empty())
+        for (const auto& [type, path] : sources)
+        {
+            m_sources.emplace(type, path);
+        }
+        start_build(build);
+    }
+    
+    Shader::Shader(const std::unordered_map<GLenum, std::string>& sources, ShaderBuild build)
+        : Shader(sources, ShaderDefines(), build)
+    {
+    }
+
+    Shader::Shader(const std::unordered_map<GLenum, std::string>& sources, const ShaderDefines& defines, ShaderBuild build)
+        : m_id(0)
+        , m_sources(sources)
+        , m_defines(defines)
+    {
+        PROFILE_SCOPE("Shader::Shader");
+
+        start_build(build);
+    }
+
+    void Shader::start_build(ShaderBuild build)
+    {
+        if (build == ShaderBuild::Deferred)
+        {
+            m_id = submit_program(m_pending);
+            m_bPending = m_id != 0;
+        }
+        else
+        {
+            m_id = create_program();
+            reflect_uniforms();
+        }
+        s_fileShaders.push_back(this);
+    }
+
+    bool Shader::init_parallel_compile(GLADloadproc loader, unsigned int maxThreads)
+    {
+        s_bParallelCompile = false;
+        s_maxCompilerThreads = nullptr;
+
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        const char* function = nullptr;
+        for (GLint i = 0; i < count && !function; ++i)
+        {
+            const char* name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+            if (std::strcmp(name, "GL_KHR_parallel_shader_compile") == 0)
             {
-                LOG_ERROR("ERROR::SHADER::FILE_EMPTY: {}", path);
-                continue;
+                function = "glMaxShaderCompilerThreadsKHR";
             }
-
-            GLuint shaderID = compile_shader(type, code);
-            if (shaderID != 0)
+            else if (std::strcmp(name, "GL_ARB_parallel_shader_compile") == 0)
             {
-                glAttachShader(m_id, shaderID);
-                shaderIDs.push_back(shaderID);
+                function = "glMaxShaderCompilerThreadsARB";
             }
         }
 
-        if (shaderIDs.empty())
+        if (!function)
         {
-            LOG_CRIT("ERROR::SHADER::NO_VALID_SHADERS_COMPILED");
-            glDeleteProgram(m_id);
-            m_id = 0;
-            return;
+            LOG_INFO("SHADER::PARALLEL_COMPILE: not supported, shaders build synchronously");
+            return false;
         }
 
-        glLinkProgram(m_id);
-        check_compile_errors(m_id, "PROGRAM");
-
-        for (GLuint id : shaderIDs)
+        s_maxCompilerThreads = reinterpret_cast<PFNGLMAXSHADERCOMPILERTHREADSPROC>(loader(function));
+        if (s_maxCompilerThreads)
         {
-            glDeleteShader(id);
+            s_maxCompilerThreads(maxThreads);
         }
+        // The completion query works even if the thread count can't be set.
+        s_bParallelCompile = true;
+        LOG_INFO("SHADER::PARALLEL_COMPILE: enabled");
+        return true;
+    }
 
-        if (is_valid())
+    bool Shader::has_parallel_compile()
+    {
+        return s_bParallelCompile;
+    }
+
+    unsigned int Shader::create_program()
+    {
+        PendingBuild pending;
+        const GLuint program = submit_program(pending);
+        if (program != 0)
         {
-            LOG_INFO("Shader program created successfully (ID: {})", m_id);
+            complete_program(program, pending);
         }
+        return program;
     }
-    
-    Shader::Shader(const std::unordered_map<GLenum, std::string>& sources)
-        : m_id(0)
+
+    unsigned int Shader::submit_program(PendingBuild& pending)
     {
-        m_id = glCreateProgram();
-        std::vector<GLuint> shaderIDs;
+        pending = PendingBuild();
+        pending.startTime = std::chrono::steady_clock::now();
 
-        for (const auto& [type, path] : sources)
+        m_files.clear();
+        ShaderCache::StageSources stages;
+        for (const auto& [type, path] : m_sources)
         {
-            if (!FileSystem::File::Exists(path))
+            ShaderPreprocessor::Result processed;
+            const bool bProcessed = ShaderPreprocessor::process(path, m_defines, processed);
+
+            // Keep watching a broken file's includes, so fixing one of them
+            // triggers a reload.
+            for (std::string& file : processed.files)
             {
-                LOG_ERROR("ERROR::SHADER::FILE_NOT_FOUND: {}", path);
-                continue;
+                m_files.push_back(std::move(file));
             }
 
-            std::string code = FileSystem::File::ReadText(path);
-            if (code.empty())
+            if (!bProcessed)
+            {
+                continue;
+            }
+            if (processed.source.empty())
             {
                 LOG_ERROR("ERROR::SHADER::FILE_EMPTY: {}", path);
                 continue;
             }
+            stages.emplace_back(type, std::move(processed.source));
+        }
 
+        if (stages.empty())
+        {
+            LOG_CRIT("ERROR::SHADER::NO_VALID_SHADERS_COMPILED");
+            return 0;
+        }
+
+        GLuint program = glCreateProgram();
+
+        pending.bCache = ShaderCache::is_available();
+        pending.cacheKey = pending.bCache ? ShaderCache::make_key(stages) : 0;
+        pending.bFromCache = pending.bCache && ShaderCache::load(pending.cacheKey, program);
+        if (pending.bFromCache)
+        {
+            return program;
+        }
+
+        // No status queries here: each one would wait for the driver to
+        // finish, serializing work it could otherwise run in the background.
+        for (const auto& [type, code] : stages)
+        {
             GLuint shaderID = compile_shader(type, code);
-            if (shaderID != 0)
+            glAttachShader(program, shaderID);
+            pending.shaders.emplace_back(type, shaderID);
+        }
+
+        if (pending.bCache)
+        {
+            glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
+        glLinkProgram(program);
+        return program;
+    }
+
+    bool Shader::complete_program(unsigned int program, PendingBuild& pending) const
+    {
+        GLint linked = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+
+        if (!pending.bFromCache)
+        {
+            // Linking has finished, so these no longer stall.
+            for (const auto& [type, shaderID] : pending.shaders)
             {
-                glAttachShader(m_id, shaderID);
-                shaderIDs.push_back(shaderID);
+                check_compile_errors(shaderID, stage_name(type));
+                glDetachShader(program, shaderID);
+                glDeleteShader(shaderID);
+            }
+            check_compile_errors(program, "PROGRAM");
+
+            if (pending.bCache && linked)
+            {
+                ShaderCache::store(pending.cacheKey, program);
             }
         }
+        pending.shaders.clear();
 
-        if (shaderIDs.empty())
+        if (linked != GL_TRUE)
         {
-            LOG_CRIT("ERROR::SHADER::NO_VALID_SHADERS_COMPILED");
-            glDeleteProgram(m_id);
-            m_id = 0;
-            return;
+            LOG_ERROR("ERROR::SHADER::PROGRAM_NOT_LINKED (ID: {})", program);
+            return false;
         }
 
-        glLinkProgram(m_id);
-        check_compile_errors(m_id, "PROGRAM");
+        const double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - pending.startTime).count();
+        LOG_INFO("Shader program created successfully (ID: {}, {:.2f} ms, {})",
+            program, elapsedMs, pending.bFromCache ? "binary cache" : "compiled");
+        return true;
+    }
+
+    void Shader::complete_pending() const
+    {
+        PROFILE_SCOPE("Shader::complete_pending");
+
+        m_bPending = false;
+        complete_program(m_id, m_pending);
+        reflect_uniforms();
+    }
 
-        for (GLuint id : shaderIDs)
+    bool Shader::is_ready() const
+    {
+        if (!m_bPending || !s_bParallelCompile)
         {
-            glDetachShader(m_id, id);
-            glDeleteShader(id);
+            return true;
         }
+        GLint done = GL_FALSE;
+        glGetProgramiv(m_id, GL_COMPLETION_STATUS_KHR, &done);
+        return done == GL_TRUE;
+    }
 
-        if (is_valid())
+    bool Shader::reload()
+    {
+        PROFILE_SCOPE("Shader::reload");
+
+        finish_build();
+        GLuint program = create_program();
+        if (program == 0)
         {
-            LOG_INFO("Shader program created successfully (ID: {})", m_id);
+            return false;
         }
+
+        GLint linked = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        if (!linked)
+        {
+            // Keep running with the last good program until the file is fixed.
+            LOG_ERROR("ERROR::SHADER::RELOAD_FAILED, keeping program {}", m_id);
+            glDeleteProgram(program);
+            return false;
+        }
+
+        if (m_id != 0)
+        {
+            glDeleteProgram(m_id);
+            StateCache::forget_program(m_id);
+        }
+        m_id = program;
+        reflect_uniforms();
+        return true;
     }
-    
+
+    bool Shader::depends_on(const std::string& path) const
+    {
+        const std::string normalized = FileSystem::Path::Normalize(path);
+        for (const auto& [type, source] : m_sources)
+        {
+            if (FileSystem::Path::Normalize(source) == normalized)
+            {
+                return true;
+            }
+        }
+        return std::find(m_files.begin(), m_files.end(), normalized) != m_files.end();
+    }
+
+    size_t Shader::reload_dependents(const std::string& path)
+    {
+        size_t reloaded = 0;
+        for (Shader* pShader : s_fileShaders)
+        {
+            if (pShader->depends_on(path) && pShader->reload())
+            {
+                LOG_INFO("SHADER::HOT_RELOAD: {} (ID: {})", path, pShader->m_id);
+                ++reloaded;
+            }
+        }
+        return reloaded;
+    }
+
     Shader::~Shader()
     {
+        untrack(this);
         destroy();
     }
 
     Shader::Shader(Shader&& other) noexcept
         : m_id(other.m_id)
-        , m_uniformCache(std::move(other.m_uniformCache))
+        , m_sources(std::move(other.m_sources))
+        , m_defines(std::move(other.m_defines))
+        , m_files(std::move(other.m_files))
+        , m_pending(std::move(other.m_pending))
+        , m_bPending(other.m_bPending)
+        , m_uniforms(std::move(other.m_uniforms))
+        , m_missingUniforms(std::move(other.m_missingUniforms))
     {
         other.m_id = 0;
+        other.m_bPending = false;
+        std::replace(s_fileShaders.begin(), s_fileShaders.end(), &other, this);
     }
 
     Shader& Shader::operator=(Shader&& other) noexcept
@@ -131,9 +358,18 @@ namespace EverEngine
             destroy();
 
             m_id = other.m_id;
-            m_uniformCache = std::move(other.m_uniformCache);
+            m_sources = std::move(other.m_sources);
+            m_defines = std::move(other.m_defines);
+            m_files = std::move(other.m_files);
+            m_pending = std::move(other.m_pending);
+            m_bPending = other.m_bPending;
+            m_uniforms = std::move(other.m_uniforms);
+            m_missingUniforms = std::move(other.m_missingUniforms);
 
             other.m_id = 0;
+            other.m_bPending = false;
+            untrack(this);
+            std::replace(s_fileShaders.begin(), s_fileShaders.end(), &other, this);
         }
 
         return *this;
@@ -141,11 +377,24 @@ namespace EverEngine
 
     void Shader::destroy()
     {
+        if (m_bPending)
+        {
+            // Dropped before first use; no need to wait for the result.
+            for (const auto& [type, shaderID] : m_pending.shaders)
+            {
+                glDeleteShader(shaderID);
+            }
+            m_pending.shaders.clear();
+            m_bPending = false;
+        }
+
         if (m_id != 0)
         {
             glDeleteProgram(m_id);
+            StateCache::forget_program(m_id);
             m_id = 0;
-            m_uniformCache.clear();
+            m_uniforms.clear();
+            m_missingUniforms.clear();
         }
     }
 
@@ -155,29 +404,6 @@ namespace EverEngine
         const char* src = source.c_str();
         glShaderSource(shader, 1, &src, nullptr);
         glCompileShader(shader);
-
-        std::string typeStr;
-        switch (type)
-        {
-            case GL_VERTEX_SHADER:   typeStr = "VERTEX"; break;
-            case GL_FRAGMENT_SHADER: typeStr = "FRAGMENT"; break;
-            case GL_GEOMETRY_SHADER: typeStr = "GEOMETRY"; break;
-            case GL_COMPUTE_SHADER: typeStr = "COMPUTE"; break;
-            case GL_TESS_EVALUATION_SHADER: typeStr = "TESS_EVALUATION"; break;
-            case GL_TESS_CONTROL_SHADER: typeStr = "TESS_CONTROL"; break;
-            
-    #ifdef GL_MESH_SHADER_NV
-            case GL_MESH_SHADER_NV: typeStr = "MESH"; break;
-    #endif
-    #ifdef GL_TASK_SHADER_NV
-            case GL_TASK_SHADER_NV: typeStr = "TASK"; break;
-    #endif
-
-            default: typeStr = "UNKNOWN"; break;
-        }
-
-        check_compile_errors(shader, typeStr);
-
         return shader;
     }
 
@@ -206,30 +432,186 @@ namespace EverEngine
         }
     }
 
-    GLint Shader::get_uniform_location(const std::string& name) const
+    void Shader::reflect_uniforms() const
     {
-        auto it = m_uniformCache.find(name);
-        if (it != m_uniformCache.end())
+        m_uniforms.clear();
+        m_missingUniforms.clear();
+
+        GLint linked = GL_FALSE;
+        if (m_id != 0)
+        {
+            glGetProgramiv(m_id, GL_LINK_STATUS, &linked);
+        }
+        if (!linked)
         {
-            return it->second;
+            return;
         }
 
-        GLint location = glGetUniformLocation(m_id, name.c_str());
+        GLint count = 0;
+        GLint maxLength = 0;
+        glGetProgramiv(m_id, GL_ACTIVE_UNIFORMS, &count);
+        glGetProgramiv(m_id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
 
-        if (location == -1)
+        std::vector<char> buffer(std::max(maxLength, 1));
+        for (GLint i = 0; i < count; ++i)
         {
-            LOG_WARN("WARNING::UNIFORM::{}::DOESN'T_EXIST", name);
+            GLsizei length = 0;
+            GLint size = 0;
+            GLenum type = 0;
+            glGetActiveUniform(m_id, i, static_cast<GLsizei>(buffer.size()), &length, &size, &type, buffer.data());
+
+            // Block members have no location and are set through buffers.
+            const GLint location = glGetUniformLocation(m_id, buffer.data());
+            if (location == -1)
+            {
+                continue;
+            }
+
+            const std::string_view name(buffer.data(), length);
+            m_uniforms.push_back({ UniformHandle::hash(name), location });
+
+            // Arrays are reported as "name[0]"; make "name" and every
+            // "name[i]" resolvable as well.
+            if (name.size() > 3 && name.substr(name.size() - 3) == "[0]")
+            {
+                const std::string base(name.substr(0, name.size() - 3));
+                m_uniforms.push_back({ UniformHandle::hash(base), location });
+                for (GLint element = 1; element < size; ++element)
+                {
+                    const std::string elementName = base + "[" + std::to_string(element) + "]";
+                    m_uniforms.push_back({ UniformHandle::hash(elementName), glGetUniformLocation(m_id, elementName.c_str()) });
+                }
+            }
         }
 
-        m_uniformCache[name] = location;
-        return location;
+        std::sort(m_uniforms.begin(), m_uniforms.end(),
+            [](const UniformSlot& a, const UniformSlot& b) { return a.hash < b.hash; });
+
+        for (size_t i = 1; i < m_uniforms.size(); ++i)
+        {
+            if (m_uniforms[i].hash == m_uniforms[i - 1].hash)
+            {
+                LOG_ERROR("ERROR::UNIFORM::HASH_COLLISION in program {}", m_id);
+            }
+        }
+    }
+
+    GLint Shader::get_uniform_location(UniformHandle uniform) const
+    {
+        finish_build();
+
+        const uint64_t hash = uniform.get_hash();
+        auto it = std::lower_bound(m_uniforms.begin(), m_uniforms.end(), hash,
+            [](const UniformSlot& slot, uint64_t value) { return slot.hash < value; });
+        if (it != m_uniforms.end() && it->hash == hash)
+        {
+            return it->location;
+        }
+
+        if (std::find(m_missingUniforms.begin(), m_missingUniforms.end(), hash) == m_missingUniforms.end())
+        {
+            m_missingUniforms.push_back(hash);
+            LOG_WARN("WARNING::UNIFORM::{}::DOESN'T_EXIST", uniform.get_name());
+        }
+        return -1;
+    }
+
+    GLuint Shader::get_block_index(std::string_view name, BufferTarget target) const
+    {
+        finish_build();
+
+        const GLenum blockInterface = target == BufferTarget::ShaderStorage ? GL_SHADER_STORAGE_BLOCK : GL_UNIFORM_BLOCK;
+        return glGetProgramResourceIndex(m_id, blockInterface, std::string(name).c_str());
+    }
+
+    bool Shader::set_block_binding(std::string_view name, GLuint binding, BufferTarget target) const
+    {
+        const GLuint index = get_block_index(name, target);
+        if (index == GL_INVALID_INDEX)
+        {
+            LOG_WARN("WARNING::BLOCK::{}::DOESN'T_EXIST", name);
+            return false;
+        }
+
+        if (target == BufferTarget::ShaderStorage)
+        {
+            glShaderStorageBlockBinding(m_id, index, binding);
+        }
+        else
+        {
+            glUniformBlockBinding(m_id, index, binding);
+        }
+        return true;
+    }
+
+    bool Shader::check_block_layout(std::string_view name, size_t size,
+        std::initializer_list<ShaderBlockMember> members, BufferTarget target) const
+    {
+        const GLuint index = get_block_index(name, target);
+        if (index == GL_INVALID_INDEX)
+        {
+            LOG_ERROR("ERROR::BLOCK_LAYOUT::{}::DOESN'T_EXIST", name);
+            return false;
+        }
+
+        const bool bStorage = target == BufferTarget::ShaderStorage;
+        const GLenum blockInterface = bStorage ? GL_SHADER_STORAGE_BLOCK : GL_UNIFORM_BLOCK;
+        const GLenum memberInterface = bStorage ? GL_BUFFER_VARIABLE : GL_UNIFORM;
+
+        bool bMatches = true;
+
+        const GLenum sizeProperty = GL_BUFFER_DATA_SIZE;
+        GLint blockSize = 0;
+        glGetProgramResourceiv(m_id, blockInterface, index, 1, &sizeProperty, 1, nullptr, &blockSize);
+        if (static_cast<size_t>(blockSize) != size)
+        {
+            LOG_ERROR("ERROR::BLOCK_LAYOUT::{}: {} bytes in GLSL, {} in C++", name, blockSize, size);
+            bMatches = false;
+        }
+
+        for (const ShaderBlockMember& member : members)
+        {
+            // Members of a block with an instance name are reported as
+            // "Block.member", arrays as "member[0]".
+            const std::string candidates[] = {
+                member.name,
+                std::string(name) + "." + member.name,
+                std::string(member.name) + "[0]",
+                std::string(name) + "." + member.name + "[0]",
+            };
+
+            GLuint memberIndex = GL_INVALID_INDEX;
+            for (const std::string& candidate : candidates)
+            {
+                memberIndex = glGetProgramResourceIndex(m_id, memberInterface, candidate.c_str());
+                if (memberIndex != GL_INVALID_INDEX) break;
+            }
+            if (memberIndex == GL_INVALID_INDEX)
+            {
+                LOG_ERROR("ERROR::BLOCK_LAYOUT::{}: member {} not found", name, member.name);
+                bMatches = false;
+                continue;
+            }
+
+            const GLenum offsetProperty = GL_OFFSET;
+            GLint offset = 0;
+            glGetProgramResourceiv(m_id, memberInterface, memberIndex, 1, &offsetProperty, 1, nullptr, &offset);
+            if (static_cast<size_t>(offset) != member.offset)
+            {
+                LOG_ERROR("ERROR::BLOCK_LAYOUT::{}: {} at offset {} in GLSL, {} in C++", name, member.name, offset, member.offset);
+                bMatches = false;
+            }
+        }
+        return bMatches;
     }
 
     void Shader::use() const
     {
+        finish_build();
+
         if (is_valid())
         {
-            glUseProgram(m_id);
+            StateCache::use_program(m_id);
         }
         else
         {
@@ -237,64 +619,64 @@ namespace EverEngine
         }
     }
 
-    void Shader::set_bool(const std::string& name, bool value) const
+    void Shader::set_bool(UniformHandle uniform, bool value) const
     {
-        glUniform1i(get_uniform_location(name), static_cast<int>(value));
+        glUniform1i(get_uniform_location(uniform), static_cast<int>(value));
     }
 
-    void Shader::set_float(const std::string& name, float value) const
+    void Shader::set_float(UniformHandle uniform, float value) const
     {
-        glUniform1f(get_uniform_location(name), value);
+        glUniform1f(get_uniform_location(uniform), value);
     }
 
-    void Shader::set_int(const std::string& name, int value) const
+    void Shader::set_int(UniformHandle uniform, int value) const
     {
-        glUniform1i(get_uniform_location(name), value);
+        glUniform1i(get_uniform_location(uniform), value);
     }
 
-    void Shader::set_vec2(const std::string& name, const glm::vec2& value) const
+    void Shader::set_vec2(UniformHandle uniform, const glm::vec2& value) const
     {
-        glUniform2fv(get_uniform_location(name), 1, &value[0]);
+        glUniform2fv(get_uniform_location(uniform), 1, &value[0]);
     }
 
-    void Shader::set_vec2(const std::string& name, float x, float y) const
+    void Shader::set_vec2(UniformHandle uniform, float x, float y) const
     {
-        glUniform2f(get_uniform_location(name), x, y);
+        glUniform2f(get_uniform_location(uniform), x, y);
     }
 
-    void Shader::set_vec3(const std::string& name, const glm::vec3& value) const
+    void Shader::set_vec3(UniformHandle uniform, const glm::vec3& value) const
     {
-        glUniform3fv(get_uniform_location(name), 1, &value[0]);
+        glUniform3fv(get_uniform_location(uniform), 1, &value[0]);
     }
 
-    void Shader::set_vec3(const std::string& name, float x, float y, float z) const
+    void Shader::set_vec3(UniformHandle uniform, float x, float y, float z) const
     {
-        glUniform3f(get_uniform_location(name), x, y, z);
+        glUniform3f(get_uniform_location(uniform), x, y, z);
     }
 
-    void Shader::set_vec4(const std::string& name, const glm::vec4& value) const
+    void Shader::set_vec4(UniformHandle uniform, const glm::vec4& value) const
     {
-        glUniform4fv(get_uniform_location(name), 1, &value[0]);
+        glUniform4fv(get_uniform_location(uniform), 1, &value[0]);
     }
 
-    void Shader::set_vec4(const std::string& name, float x, float y, float z, float w) const
+    void Shader::set_vec4(UniformHandle uniform, float x, float y, float z, float w) const
     {
-        glUniform4f(get_uniform_location(name), x, y, z, w);
+        glUniform4f(get_uniform_location(uniform), x, y, z, w);
     }
 
-    void Shader::set_mat2(const std::string& name, const glm::mat2& value) const
+    void Shader::set_mat2(UniformHandle uniform, const glm::mat2& value) const
     {
-        glUniformMatrix2fv(get_uniform_location(name), 1, GL_FALSE, &value[0][0]);
+        glUniformMatrix2fv(get_uniform_location(uniform), 1, GL_FALSE, &value[0][0]);
     }
 
-    void Shader::set_mat3(const std::string& name, const glm::mat3& value) const
+    void Shader::set_mat3(UniformHandle uniform, const glm::mat3& value) const
     {
-        glUniformMatrix3fv(get_uniform_location(name), 1, GL_FALSE, &value[0][0]);
+        glUniformMatrix3fv(get_uniform_location(uniform), 1, GL_FALSE, &value[0][0]);
     }
 
-    void Shader::set_mat4(const std::string& name, const glm::mat4& value) const
+    void Shader::set_mat4(UniformHandle uniform, const glm::mat4& value) const
     {
-        glUniformMatrix4fv(get_uniform_location(name), 1, GL_FALSE, &value[0][0]);
+        glUniformMatrix4fv(get_uniform_location(uniform), 1, GL_FALSE, &value[0][0]);
     }
 
 } // namespace EverEngine
\ No newline at end of file
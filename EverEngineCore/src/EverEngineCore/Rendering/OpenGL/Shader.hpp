@@ -4,8 +4,17 @@
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 
+#include "ShaderPreprocessor.hpp"
+#include "ShaderBuffer.hpp"
+
 #include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+#include <initializer_list>
 #include <unordered_map>
+#include <vector>
+#include <chrono>
 
 namespace EverEngine
 {
@@ -44,11 +53,69 @@ namespace EverEngine
         static constexpr GLenum TessControl = ShaderType::ToGL(ShaderType::Type::TessControl);
     };
     
+    enum class ShaderBuild
+    {
+        // Compile and link before the constructor returns.
+        Immediate,
+        // Submit compile and link and return; status is checked on first use.
+        // Construct many shaders this way so the driver can overlap them.
+        Deferred
+    };
+
+    // Uniform name hashed at compile time. Declare once, e.g.
+    //     static constexpr UniformHandle u_model("u_model");
+    // or write "u_model"_uniform, and setters skip all string work.
+    class UniformHandle
+    {
+    public:
+        constexpr explicit UniformHandle(std::string_view name)
+            : m_hash(hash(name))
+            , m_name(name)
+        {
+        }
+
+        constexpr uint64_t get_hash() const { return m_hash; }
+        constexpr std::string_view get_name() const { return m_name; }
+
+        static constexpr uint64_t hash(std::string_view name)
+        {
+            // FNV-1a
+            uint64_t value = 14695981039346656037ull;
+            for (char c : name)
+            {
+                value ^= static_cast<uint8_t>(c);
+                value *= 1099511628211ull;
+            }
+            return value;
+        }
+
+    private:
+        uint64_t m_hash;
+        std::string_view m_name;
+    };
+
+    constexpr UniformHandle operator""_uniform(const char* name, size_t length)
+    {
+        return UniformHandle(std::string_view(name, length));
+    }
+
+    // One member of a C++ struct mirroring a GLSL block, for
+    // Shader::check_block_layout.
+    struct ShaderBlockMember
+    {
+        const char* name;
+        size_t offset;
+    };
+
+    #define SHADER_BLOCK_MEMBER(Type, member) ::EverEngine::ShaderBlockMember{ #member, offsetof(Type, member) }
+
     class Shader
     {
     public:
-        Shader(const std::unordered_map<unsigned int, const char*>& sources);
-        Shader(const std::unordered_map<unsigned int, std::string>& sources);
+        Shader(const std::unordered_map<unsigned int, const char*>& sources, ShaderBuild build = ShaderBuild::Immediate);
+        Shader(const std::unordered_map<unsigned int, std::string>& sources, ShaderBuild build = ShaderBuild::Immediate);
+        // Every stage is preprocessed with the given defines.
+        Shader(const std::unordered_map<unsigned int, std::string>& sources, const ShaderDefines& defines, ShaderBuild build = ShaderBuild::Immediate);
         ~Shader();
 
         Shader(const Shader&) = delete;
@@ -57,36 +124,122 @@ namespace EverEngine
         Shader(Shader&& other) noexcept;
         Shader& operator=(Shader&& other) noexcept;
 
-        unsigned int get_program() const { return m_id; }
+        unsigned int get_program() const { finish_build(); return m_id; }
         bool is_valid() const { return m_id != 0; }
 
+        // True once a deferred build can be finished without blocking. Always
+        // true without KHR_parallel_shader_compile.
+        bool is_ready() const;
+
         void use() const;
 
-        void set_bool(const std::string& name, bool value) const;
-        void set_float(const std::string& name, float value) const;
-        void set_int(const std::string& name, int value) const;
-        
-        void set_vec2(const std::string& name, const glm::vec2& value) const;
-        void set_vec2(const std::string& name, float x, float y) const;
-        void set_vec3(const std::string& name, const glm::vec3& value) const;
-        void set_vec3(const std::string& name, float x, float y, float z) const;
-        void set_vec4(const std::string& name, const glm::vec4& value) const;
-        void set_vec4(const std::string& name, float x, float y, float z, float w) const;
-
-        void set_mat2(const std::string& name, const glm::mat2& value) const;
-        void set_mat3(const std::string& name, const glm::mat3& value) const;
-        void set_mat4(const std::string& name, const glm::mat4& value) const;
+        // Rebuilds the program from its source files in place. On failure
+        // the previous program stays in use.
+        bool reload();
+        // True for the stage files and anything they #include.
+        bool depends_on(const std::string& path) const;
+
+        // Reloads every live shader built from the given file.
+        static size_t reload_dependents(const std::string& path);
+
+        // Looks up KHR/ARB_parallel_shader_compile and lets the driver use
+        // up to maxThreads compiler threads (0xFFFFFFFF: driver's choice).
+        // Call once after glad has been loaded.
+        static bool init_parallel_compile(GLADloadproc loader, unsigned int maxThreads = 0xFFFFFFFF);
+        static bool has_parallel_compile();
+
+        // Names are hashed per call; prefer the UniformHandle overloads in
+        // per-draw code.
+        void set_bool(std::string_view name, bool value) const { set_bool(UniformHandle(name), value); }
+        void set_float(std::string_view name, float value) const { set_float(UniformHandle(name), value); }
+        void set_int(std::string_view name, int value) const { set_int(UniformHandle(name), value); }
+
+        void set_vec2(std::string_view name, const glm::vec2& value) const { set_vec2(UniformHandle(name), value); }
+        void set_vec2(std::string_view name, float x, float y) const { set_vec2(UniformHandle(name), x, y); }
+        void set_vec3(std::string_view name, const glm::vec3& value) const { set_vec3(UniformHandle(name), value); }
+        void set_vec3(std::string_view name, float x, float y, float z) const { set_vec3(UniformHandle(name), x, y, z); }
+        void set_vec4(std::string_view name, const glm::vec4& value) const { set_vec4(UniformHandle(name), value); }
+        void set_vec4(std::string_view name, float x, float y, float z, float w) const { set_vec4(UniformHandle(name), x, y, z, w); }
+
+        void set_mat2(std::string_view name, const glm::mat2& value) const { set_mat2(UniformHandle(name), value); }
+        void set_mat3(std::string_view name, const glm::mat3& value) const { set_mat3(UniformHandle(name), value); }
+        void set_mat4(std::string_view name, const glm::mat4& value) const { set_mat4(UniformHandle(name), value); }
+
+        void set_bool(UniformHandle uniform, bool value) const;
+        void set_float(UniformHandle uniform, float value) const;
+        void set_int(UniformHandle uniform, int value) const;
+
+        void set_vec2(UniformHandle uniform, const glm::vec2& value) const;
+        void set_vec2(UniformHandle uniform, float x, float y) const;
+        void set_vec3(UniformHandle uniform, const glm::vec3& value) const;
+        void set_vec3(UniformHandle uniform, float x, float y, float z) const;
+        void set_vec4(UniformHandle uniform, const glm::vec4& value) const;
+        void set_vec4(UniformHandle uniform, float x, float y, float z, float w) const;
+
+        void set_mat2(UniformHandle uniform, const glm::mat2& value) const;
+        void set_mat3(UniformHandle uniform, const glm::mat3& value) const;
+        void set_mat4(UniformHandle uniform, const glm::mat4& value) const;
+
+        // -1 when the program has no such active uniform.
+        GLint get_uniform_location(UniformHandle uniform) const;
+
+        // Uniform blocks for BufferTarget::Uniform, shader storage blocks for
+        // BufferTarget::ShaderStorage. GL_INVALID_INDEX if there is none.
+        GLuint get_block_index(std::string_view name, BufferTarget target = BufferTarget::Uniform) const;
+        bool set_block_binding(std::string_view name, GLuint binding, BufferTarget target = BufferTarget::Uniform) const;
+
+        // Compares a C++ struct against the linked block's size and member
+        // offsets and logs every mismatch. Run once after loading, e.g.
+        //     shader.check_block_layout("Object", sizeof(ObjectData),
+        //         { SHADER_BLOCK_MEMBER(ObjectData, model), SHADER_BLOCK_MEMBER(ObjectData, color) });
+        bool check_block_layout(std::string_view name, size_t size,
+            std::initializer_list<ShaderBlockMember> members,
+            BufferTarget target = BufferTarget::Uniform) const;
 
     private:
+        // Compile work submitted but not yet checked.
+        struct PendingBuild
+        {
+            std::vector<std::pair<GLenum, GLuint>> shaders;
+            uint64_t cacheKey = 0;
+            bool bCache = false;
+            bool bFromCache = false;
+            std::chrono::steady_clock::time_point startTime;
+        };
+
         unsigned int m_id;
+        std::unordered_map<unsigned int, std::string> m_sources;
+        ShaderDefines m_defines;
+        // Every file read by the last build, includes too.
+        std::vector<std::string> m_files;
+
+        mutable PendingBuild m_pending;
+        mutable bool m_bPending = false;
+
+        void start_build(ShaderBuild build);
+        unsigned int create_program();
+        unsigned int submit_program(PendingBuild& pending);
+        bool complete_program(unsigned int program, PendingBuild& pending) const;
+        void finish_build() const { if (m_bPending) complete_pending(); }
+        void complete_pending() const;
 
         unsigned int compile_shader(unsigned int type, const std::string& source) const;
         void check_compile_errors(unsigned int shader, const std::string& type) const;
         void destroy();
 
-        GLint get_uniform_location(const std::string& name) const;
+        // Filled from GL_ACTIVE_UNIFORMS once the program has linked.
+        struct UniformSlot
+        {
+            uint64_t hash;
+            GLint location;
+        };
+
+        void reflect_uniforms() const;
 
-        mutable std::unordered_map<std::string, GLint> m_uniformCache;
+        // Sorted by hash.
+        mutable std::vector<UniformSlot> m_uniforms;
+        // Names already warned about, so a missing uniform logs once.
+        mutable std::vector<uint64_t> m_missingUniforms;
     };
 
 }
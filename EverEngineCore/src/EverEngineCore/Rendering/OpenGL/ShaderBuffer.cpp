@@ -0,0 +1,104 @@
+#include "ShaderBuffer.hpp"
+#include "StateCache.hpp"
+#include "EverEngineCore/Log.hpp"
+
+namespace EverEngine
+{
+    GLint get_buffer_offset_alignment(BufferTarget target)
+    {
+        // Constant for the lifetime of the context.
+        static GLint s_uniformAlignment = 0;
+        static GLint s_storageAlignment = 0;
+
+        switch (target)
+        {
+            case BufferTarget::Uniform:
+                if (s_uniformAlignment == 0)
+                {
+                    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &s_uniformAlignment);
+                }
+                return s_uniformAlignment > 0 ? s_uniformAlignment : 256;
+            case BufferTarget::ShaderStorage:
+                if (s_storageAlignment == 0)
+                {
+                    glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &s_storageAlignment);
+                }
+                return s_storageAlignment > 0 ? s_storageAlignment : 256;
+            default:
+                return 4;
+        }
+    }
+
+    ShaderBuffer::ShaderBuffer(BufferTarget target, size_t size, const void* data, BufferUsage usage)
+        : m_id(0)
+        , m_size(size)
+        , m_target(target)
+    {
+        // Uploads go through the copy target: binding GL_ELEMENT_ARRAY_BUFFER
+        // would replace the index buffer of whatever VAO is bound.
+        glGenBuffers(1, &m_id);
+        StateCache::bind_buffer(GL_COPY_WRITE_BUFFER, m_id);
+        glBufferData(GL_COPY_WRITE_BUFFER, size, data, static_cast<GLenum>(usage));
+    }
+
+    ShaderBuffer::~ShaderBuffer()
+    {
+        destroy();
+    }
+
+    ShaderBuffer::ShaderBuffer(ShaderBuffer&& other) noexcept
+        : m_id(other.m_id)
+        , m_size(other.m_size)
+        , m_target(other.m_target)
+    {
+        other.m_id = 0;
+        other.m_size = 0;
+    }
+
+    ShaderBuffer& ShaderBuffer::operator=(ShaderBuffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            destroy();
+
+            m_id = other.m_id;
+            m_size = other.m_size;
+            m_target = other.m_target;
+
+            other.m_id = 0;
+            other.m_size = 0;
+        }
+        return *this;
+    }
+
+    void ShaderBuffer::destroy()
+    {
+        if (m_id != 0)
+        {
+            glDeleteBuffers(1, &m_id);
+            StateCache::forget_buffer(m_id);
+            m_id = 0;
+        }
+    }
+
+    void ShaderBuffer::update(const void* data, size_t size, size_t offset)
+    {
+        if (offset + size > m_size)
+        {
+            LOG_ERROR("ERROR::SHADER_BUFFER::UPDATE_OUT_OF_RANGE: {} + {} > {}", offset, size, m_size);
+            return;
+        }
+        StateCache::bind_buffer(GL_COPY_WRITE_BUFFER, m_id);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, data);
+    }
+
+    void ShaderBuffer::bind_base(GLuint binding) const
+    {
+        StateCache::bind_buffer_base(static_cast<GLenum>(m_target), binding, m_id);
+    }
+
+    void ShaderBuffer::bind_range(GLuint binding, size_t offset, size_t size) const
+    {
+        StateCache::bind_buffer_range(static_cast<GLenum>(m_target), binding, m_id, offset, size);
+    }
+}
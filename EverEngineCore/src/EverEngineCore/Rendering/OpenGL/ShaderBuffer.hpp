@@ -0,0 +1,65 @@
+#ifndef SHADER_BUFFER_HPP
+#define SHADER_BUFFER_HPP
+
+#include "VertexBuffer.hpp"
+
+#include <glad/glad.h>
+#include <cstddef>
+
+namespace EverEngine
+{
+    enum class BufferTarget
+    {
+        Array = GL_ARRAY_BUFFER,
+        ElementArray = GL_ELEMENT_ARRAY_BUFFER,
+        Uniform = GL_UNIFORM_BUFFER,
+        ShaderStorage = GL_SHADER_STORAGE_BUFFER,
+        DrawIndirect = GL_DRAW_INDIRECT_BUFFER,
+    };
+
+    // Offsets passed to glBindBufferRange must be multiples of this for
+    // uniform and storage buffers; 4 for every other target.
+    GLint get_buffer_offset_alignment(BufferTarget target);
+
+    // Buffer backing a uniform block (std140) or shader storage block
+    // (std430). Mirror the block with a C++ struct using alignas(16) on vec3,
+    // vec4 and matrix members, and check it once with
+    // Shader::check_block_layout.
+    class ShaderBuffer
+    {
+    public:
+        ShaderBuffer(BufferTarget target, size_t size, const void* data = nullptr,
+                    BufferUsage usage = BufferUsage::Dynamic);
+        ~ShaderBuffer();
+
+        ShaderBuffer(const ShaderBuffer&) = delete;
+        ShaderBuffer& operator=(const ShaderBuffer&) = delete;
+
+        ShaderBuffer(ShaderBuffer&& other) noexcept;
+        ShaderBuffer& operator=(ShaderBuffer&& other) noexcept;
+
+        GLuint get_id() const { return m_id; }
+        size_t get_size() const { return m_size; }
+        BufferTarget get_target() const { return m_target; }
+
+        void update(const void* data, size_t size, size_t offset = 0);
+
+        template<typename T>
+        void update(const T& value, size_t offset = 0)
+        {
+            update(&value, sizeof(T), offset);
+        }
+
+        void bind_base(GLuint binding) const;
+        void bind_range(GLuint binding, size_t offset, size_t size) const;
+
+    private:
+        void destroy();
+
+        GLuint m_id;
+        size_t m_size;
+        BufferTarget m_target;
+    };
+}
+
+#endif // SHADER_BUFFER_HPP
@@ -0,0 +1,220 @@
+#include "ShaderCache.hpp"
+#include "EverEngineCore/Log.hpp"
+#include "EverEngineCore/Profiler.hpp"
+#include "../../Platform/Generic/FileSystem.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace EverEngine
+{
+    namespace
+    {
+        struct CacheHeader
+        {
+            static constexpr uint32_t Magic = 0x43425345; // "ESBC"
+            static constexpr uint32_t CurrentVersion = 1;
+
+            uint32_t magic;
+            uint32_t version;
+            uint64_t key;
+            uint32_t format;
+            uint32_t length;
+        };
+        static_assert(sizeof(CacheHeader) == 24);
+
+        std::string s_directory;
+        bool s_bEnabled = true;
+        // -1 until the driver has been asked.
+        int s_binaryFormats = -1;
+
+        uint64_t hash_bytes(uint64_t hash, const void* data, size_t size)
+        {
+            // FNV-1a
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        uint64_t hash_string(uint64_t hash, std::string_view text)
+        {
+            // Length first so ("ab", "c") and ("a", "bc") differ.
+            const uint64_t length = text.size();
+            hash = hash_bytes(hash, &length, sizeof(length));
+            return hash_bytes(hash, text.data(), text.size());
+        }
+
+        std::string_view gl_string(GLenum name)
+        {
+            const GLubyte* value = glGetString(name);
+            return value ? reinterpret_cast<const char*>(value) : "";
+        }
+
+        std::string entry_path(uint64_t key)
+        {
+            char name[32];
+            std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+            return FileSystem::Path::Join(ShaderCache::get_directory(), name);
+        }
+    }
+
+    void ShaderCache::set_directory(const std::string& directory)
+    {
+        s_directory = directory;
+    }
+
+    const std::string& ShaderCache::get_directory()
+    {
+        if (s_directory.empty())
+        {
+            s_directory = FileSystem::Path::Join(FileSystem::Directory::GetTemp(), "everengine_shader_cache");
+        }
+        return s_directory;
+    }
+
+    void ShaderCache::set_enabled(bool bEnabled)
+    {
+        s_bEnabled = bEnabled;
+    }
+
+    bool ShaderCache::is_available()
+    {
+        if (!s_bEnabled)
+        {
+            return false;
+        }
+        if (s_binaryFormats < 0)
+        {
+            GLint formats = 0;
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+            s_binaryFormats = formats;
+            if (formats == 0)
+            {
+                LOG_WARN("WARNING::SHADER_CACHE::NO_BINARY_FORMATS, program binaries will not be cached");
+            }
+        }
+        return s_binaryFormats > 0;
+    }
+
+    uint64_t ShaderCache::make_key(const StageSources& stages, std::string_view options)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        hash = hash_bytes(hash, &CacheHeader::CurrentVersion, sizeof(CacheHeader::CurrentVersion));
+
+        // Binaries are only valid for the driver that produced them.
+        hash = hash_string(hash, gl_string(GL_VENDOR));
+        hash = hash_string(hash, gl_string(GL_RENDERER));
+        hash = hash_string(hash, gl_string(GL_VERSION));
+
+        // Stage order must not depend on the caller's container.
+        std::vector<const std::pair<GLenum, std::string>*> sorted;
+        sorted.reserve(stages.size());
+        for (const auto& stage : stages)
+        {
+            sorted.push_back(&stage);
+        }
+        std::sort(sorted.begin(), sorted.end(), [](const auto* a, const auto* b) { return a->first < b->first; });
+
+        for (const auto* stage : sorted)
+        {
+            hash = hash_bytes(hash, &stage->first, sizeof(stage->first));
+            hash = hash_string(hash, stage->second);
+        }
+        return hash_string(hash, options);
+    }
+
+    bool ShaderCache::load(uint64_t key, GLuint program)
+    {
+        PROFILE_SCOPE("ShaderCache::load");
+
+        const std::string path = entry_path(key);
+        if (!FileSystem::File::IsFile(path))
+        {
+            return false;
+        }
+
+        const std::vector<uint8_t> data = FileSystem::File::ReadBinary(path);
+
+        CacheHeader header;
+        if (data.size() < sizeof(header))
+        {
+            FileSystem::File::Delete(path);
+            return false;
+        }
+        std::memcpy(&header, data.data(), sizeof(header));
+
+        if (header.magic != CacheHeader::Magic || header.version != CacheHeader::CurrentVersion ||
+            header.key != key || header.length != data.size() - sizeof(header))
+        {
+            FileSystem::File::Delete(path);
+            return false;
+        }
+
+        glProgramBinary(program, header.format, data.data() + sizeof(header), static_cast<GLsizei>(header.length));
+
+        GLint linked = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        if (!linked)
+        {
+            // The driver may reject its own old binaries, e.g. after an
+            // update that kept the version string.
+            LOG_WARN("WARNING::SHADER_CACHE::BINARY_REJECTED: {0}", path);
+            FileSystem::File::Delete(path);
+            return false;
+        }
+        return true;
+    }
+
+    void ShaderCache::store(uint64_t key, GLuint program)
+    {
+        PROFILE_SCOPE("ShaderCache::store");
+
+        GLint length = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0)
+        {
+            return;
+        }
+
+        std::vector<uint8_t> data(sizeof(CacheHeader) + length);
+
+        GLsizei written = 0;
+        GLenum format = 0;
+        glGetProgramBinary(program, length, &written, &format, data.data() + sizeof(CacheHeader));
+        if (written <= 0)
+        {
+            return;
+        }
+        data.resize(sizeof(CacheHeader) + written);
+
+        CacheHeader header;
+        header.magic = CacheHeader::Magic;
+        header.version = CacheHeader::CurrentVersion;
+        header.key = key;
+        header.format = format;
+        header.length = static_cast<uint32_t>(written);
+        std::memcpy(data.data(), &header, sizeof(header));
+
+        const std::string& directory = get_directory();
+        if (!FileSystem::Directory::CreateRecursive(directory))
+        {
+            LOG_WARN("WARNING::SHADER_CACHE::CREATE_DIRECTORY_FAILED: {0}", directory);
+            return;
+        }
+
+        // Write then rename, so a crash never leaves a truncated entry behind.
+        const std::string path = entry_path(key);
+        const std::string tempPath = path + ".tmp";
+        if (!FileSystem::File::WriteBinary(tempPath, data.data(), data.size()) ||
+            !FileSystem::File::Move(tempPath, path))
+        {
+            LOG_WARN("WARNING::SHADER_CACHE::WRITE_FAILED: {0}", path);
+            FileSystem::File::Delete(tempPath);
+        }
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef SHADER_CACHE_HPP
+#define SHADER_CACHE_HPP
+
+#include <glad/glad.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace EverEngine
+{
+    // On-disk cache of linked program binaries (glGetProgramBinary). Entries
+    // are keyed by a hash of every stage's source, the build options and the
+    // driver identity, so an edited shader or a driver update simply misses.
+    class ShaderCache
+    {
+    public:
+        using StageSources = std::vector<std::pair<GLenum, std::string>>;
+
+        // Defaults to <temp>/everengine_shader_cache.
+        static void set_directory(const std::string& directory);
+        static const std::string& get_directory();
+
+        static void set_enabled(bool bEnabled);
+        // False when disabled or when the driver offers no binary formats.
+        static bool is_available();
+
+        // options covers anything else that changes the program, such as
+        // preprocessor defines.
+        static uint64_t make_key(const StageSources& stages, std::string_view options = {});
+
+        // Loads a cached binary into program. A missing, stale or rejected
+        // entry returns false and the caller compiles from source.
+        static bool load(uint64_t key, GLuint program);
+        // Stores a linked program. It must have been linked with
+        // GL_PROGRAM_BINARY_RETRIEVABLE_HINT set.
+        static void store(uint64_t key, GLuint program);
+    };
+}
+
+#endif
@@ -0,0 +1,236 @@
+#include "ShaderPreprocessor.hpp"
+#include "EverEngineCore/Log.hpp"
+#include "EverEngineCore/Profiler.hpp"
+#include "../../Platform/Generic/FileSystem.hpp"
+
+#include <algorithm>
+#include <string_view>
+#include <unordered_set>
+
+namespace EverEngine
+{
+    namespace
+    {
+        constexpr size_t MaxIncludeDepth = 32;
+
+        struct Context
+        {
+            ShaderPreprocessor::Result& result;
+            const ShaderDefines& defines;
+            // Files currently being expanded, to catch include cycles.
+            std::vector<std::string> stack;
+            std::unordered_set<std::string> onceFiles;
+        };
+
+        std::string_view trim(std::string_view text)
+        {
+            const size_t first = text.find_first_not_of(" \t");
+            if (first == std::string_view::npos) return {};
+            const size_t last = text.find_last_not_of(" \t\r");
+            return text.substr(first, last - first + 1);
+        }
+
+        // Splits "#  name rest" into name and rest.
+        bool parse_directive(std::string_view line, std::string_view& name, std::string_view& rest)
+        {
+            line = trim(line);
+            if (line.empty() || line.front() != '#') return false;
+
+            line = trim(line.substr(1));
+            const size_t end = line.find_first_of(" \t");
+            name = line.substr(0, end);
+            rest = end == std::string_view::npos ? std::string_view() : trim(line.substr(end));
+            return true;
+        }
+
+        bool parse_include_path(std::string_view rest, std::string_view& path)
+        {
+            if (rest.size() < 2) return false;
+
+            const char close = rest.front() == '"' ? '"' : rest.front() == '<' ? '>' : '\0';
+            if (close == '\0') return false;
+
+            const size_t end = rest.find(close, 1);
+            if (end == std::string_view::npos) return false;
+
+            path = rest.substr(1, end - 1);
+            return !path.empty();
+        }
+
+        // Joins an include onto the including file's directory and folds "."
+        // and ".." so the same file always gets the same name.
+        std::string resolve_path(const std::string& includer, std::string_view include)
+        {
+            const std::string joined = FileSystem::Path::IsAbsolute(std::string(include))
+                ? std::string(include)
+                : FileSystem::Path::Join(FileSystem::Path::GetDirectory(includer), std::string(include));
+
+            std::vector<std::string_view> parts;
+            std::string_view remaining = joined;
+            const bool bRooted = !remaining.empty() && (remaining.front() == '/' || remaining.front() == '\\');
+            while (!remaining.empty())
+            {
+                const size_t end = remaining.find_first_of("/\\");
+                const std::string_view part = remaining.substr(0, end);
+                remaining = end == std::string_view::npos ? std::string_view() : remaining.substr(end + 1);
+
+                if (part.empty() || part == ".") continue;
+                if (part == ".." && !parts.empty() && parts.back() != "..")
+                {
+                    parts.pop_back();
+                    continue;
+                }
+                parts.push_back(part);
+            }
+
+            std::string result = bRooted ? std::string(1, FileSystem::Path::Separator) : std::string();
+            for (size_t i = 0; i < parts.size(); ++i)
+            {
+                if (i > 0) result += FileSystem::Path::Separator;
+                result += parts[i];
+            }
+            return result;
+        }
+
+        bool has_version(std::string_view code)
+        {
+            std::string_view name, rest;
+            while (!code.empty())
+            {
+                const size_t end = code.find('\n');
+                if (parse_directive(code.substr(0, end), name, rest) && name == "version") return true;
+                code = end == std::string_view::npos ? std::string_view() : code.substr(end + 1);
+            }
+            return false;
+        }
+
+        void emit_defines(Context& context, size_t nextLine)
+        {
+            for (const std::string& define : context.defines)
+            {
+                context.result.source += "#define ";
+                context.result.source += define;
+                context.result.source += '\n';
+            }
+            context.result.source += "#line " + std::to_string(nextLine) + " 0\n";
+        }
+
+        bool expand(Context& context, const std::string& path)
+        {
+            const std::string name = FileSystem::Path::Normalize(path);
+            if (context.onceFiles.count(name))
+            {
+                return true;
+            }
+            if (std::find(context.stack.begin(), context.stack.end(), name) != context.stack.end())
+            {
+                LOG_ERROR("ERROR::SHADER::INCLUDE_CYCLE: {}", path);
+                return false;
+            }
+            if (context.stack.size() >= MaxIncludeDepth)
+            {
+                LOG_ERROR("ERROR::SHADER::INCLUDE_TOO_DEEP: {}", path);
+                return false;
+            }
+
+            const std::string code = FileSystem::File::ReadText(path);
+            if (code.empty() && !FileSystem::File::Exists(path))
+            {
+                LOG_ERROR("ERROR::SHADER::FILE_NOT_FOUND: {}", path);
+                return false;
+            }
+
+            std::vector<std::string>& files = context.result.files;
+            auto it = std::find(files.begin(), files.end(), name);
+            const size_t fileIndex = it - files.begin();
+            if (it == files.end())
+            {
+                files.push_back(name);
+            }
+
+            const bool bRoot = context.stack.empty();
+            bool bDefinesPending = bRoot && !context.defines.empty();
+            if (bDefinesPending && !has_version(code))
+            {
+                emit_defines(context, 1);
+                bDefinesPending = false;
+            }
+
+            std::string& out = context.result.source;
+            if (!bRoot)
+            {
+                out += "#line 1 " + std::to_string(fileIndex) + "\n";
+            }
+
+            context.stack.push_back(name);
+
+            std::string_view remaining = code;
+            size_t lineNumber = 0;
+            while (!remaining.empty())
+            {
+                const size_t end = remaining.find('\n');
+                const std::string_view line = remaining.substr(0, end);
+                remaining = end == std::string_view::npos ? std::string_view() : remaining.substr(end + 1);
+                ++lineNumber;
+
+                std::string_view directive, rest;
+                if (!parse_directive(line, directive, rest))
+                {
+                    out += line;
+                    out += '\n';
+                    continue;
+                }
+
+                if (directive == "include")
+                {
+                    std::string_view include;
+                    if (!parse_include_path(rest, include))
+                    {
+                        LOG_ERROR("ERROR::SHADER::BAD_INCLUDE: {}({}): {}", path, lineNumber, line);
+                        return false;
+                    }
+                    if (!expand(context, resolve_path(path, include)))
+                    {
+                        LOG_ERROR("ERROR::SHADER::INCLUDED_FROM: {}({})", path, lineNumber);
+                        return false;
+                    }
+                    out += "#line " + std::to_string(lineNumber + 1) + " " + std::to_string(fileIndex) + "\n";
+                }
+                else if (directive == "pragma" && rest == "once")
+                {
+                    context.onceFiles.insert(name);
+                    out += '\n';
+                }
+                else
+                {
+                    out += line;
+                    out += '\n';
+                    if (bDefinesPending && directive == "version")
+                    {
+                        emit_defines(context, lineNumber + 1);
+                        bDefinesPending = false;
+                    }
+                }
+            }
+
+            context.stack.pop_back();
+            return true;
+        }
+    }
+
+    bool ShaderPreprocessor::process(const std::string& path, const ShaderDefines& defines, Result& result)
+    {
+        PROFILE_SCOPE("ShaderPreprocessor::process");
+
+        result.source.clear();
+        result.files.clear();
+
+        Context context{ result, defines, {}, {} };
+        if (!expand(context, path))
+        {
+            result.source.clear();
+            return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,33 @@
+#ifndef SHADER_PREPROCESSOR_HPP
+#define SHADER_PREPROCESSOR_HPP
+
+#include <string>
+#include <vector>
+
+namespace EverEngine
+{
+    // "NAME" or "NAME VALUE", emitted as #define lines.
+    using ShaderDefines = std::vector<std::string>;
+
+    // Expands a GLSL file before it is handed to the driver:
+    //  - #include "file" (or <file>), resolved relative to the including file
+    //    and read through FileSystem, so archived assets work too
+    //  - #pragma once
+    //  - defines injected right after #version
+    // #line directives keep driver error messages pointing at the right
+    // line; the source string number is the file's index in files.
+    class ShaderPreprocessor
+    {
+    public:
+        struct Result
+        {
+            std::string source;
+            // Every file read, the root first. Used for hot reload.
+            std::vector<std::string> files;
+        };
+
+        static bool process(const std::string& path, const ShaderDefines& defines, Result& result);
+    };
+}
+
+#endif
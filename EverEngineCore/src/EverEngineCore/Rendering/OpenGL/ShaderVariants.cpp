@@ -0,0 +1,68 @@
+#include "ShaderVariants.hpp"
+#include "EverEngineCore/Log.hpp"
+#include "EverEngineCore/Profiler.hpp"
+
+namespace EverEngine
+{
+    ShaderVariants::ShaderVariants(const std::unordered_map<unsigned int, std::string>& sources,
+        const std::vector<std::string>& features,
+        const ShaderDefines& defines)
+        : m_sources(sources)
+        , m_features(features)
+        , m_defines(defines)
+    {
+        if (m_features.size() > MaxFeatures)
+        {
+            LOG_ERROR("ERROR::SHADER_VARIANTS::TOO_MANY_FEATURES: {}, keeping the first {}", m_features.size(), MaxFeatures);
+            m_features.resize(MaxFeatures);
+        }
+        m_validMask = m_features.size() == MaxFeatures ? ~uint64_t(0) : (uint64_t(1) << m_features.size()) - 1;
+    }
+
+    Shader& ShaderVariants::get(uint64_t mask)
+    {
+        return find_or_build(mask, ShaderBuild::Immediate);
+    }
+
+    void ShaderVariants::prepare(uint64_t mask)
+    {
+        find_or_build(mask, ShaderBuild::Deferred);
+    }
+
+    uint64_t ShaderVariants::get_feature_bit(const std::string& feature) const
+    {
+        for (size_t i = 0; i < m_features.size(); ++i)
+        {
+            if (m_features[i] == feature)
+            {
+                return uint64_t(1) << i;
+            }
+        }
+        return 0;
+    }
+
+    Shader& ShaderVariants::find_or_build(uint64_t mask, ShaderBuild build)
+    {
+        // Unknown bits would otherwise build duplicates of the same program.
+        mask &= m_validMask;
+
+        auto it = m_variants.find(mask);
+        if (it != m_variants.end())
+        {
+            return it->second;
+        }
+
+        PROFILE_SCOPE("ShaderVariants::build");
+
+        ShaderDefines defines = m_defines;
+        for (size_t i = 0; i < m_features.size(); ++i)
+        {
+            if (mask & (uint64_t(1) << i))
+            {
+                defines.push_back(m_features[i]);
+            }
+        }
+
+        return m_variants.try_emplace(mask, m_sources, defines, build).first->second;
+    }
+}
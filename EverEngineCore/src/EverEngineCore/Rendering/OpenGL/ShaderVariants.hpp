@@ -0,0 +1,51 @@
+#ifndef SHADER_VARIANTS_HPP
+#define SHADER_VARIANTS_HPP
+
+#include "Shader.hpp"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace EverEngine
+{
+    // Permutations of one shader, built on demand. Each feature is a define
+    // switched on by one bit of the mask, so toggling features per draw is a
+    // single map lookup and a permutation is only ever compiled once.
+    class ShaderVariants
+    {
+    public:
+        static constexpr size_t MaxFeatures = 64;
+
+        // defines are added to every permutation.
+        ShaderVariants(const std::unordered_map<unsigned int, std::string>& sources,
+            const std::vector<std::string>& features,
+            const ShaderDefines& defines = {});
+
+        ShaderVariants(const ShaderVariants&) = delete;
+        ShaderVariants& operator=(const ShaderVariants&) = delete;
+
+        // Builds the permutation the first time it is asked for.
+        Shader& get(uint64_t mask);
+        // Starts a deferred build, e.g. at load time, so get() won't stall.
+        void prepare(uint64_t mask);
+
+        // The feature's bit, or 0 if there is no such feature.
+        uint64_t get_feature_bit(const std::string& feature) const;
+        size_t get_variant_count() const { return m_variants.size(); }
+
+    private:
+        Shader& find_or_build(uint64_t mask, ShaderBuild build);
+
+        std::unordered_map<unsigned int, std::string> m_sources;
+        std::vector<std::string> m_features;
+        ShaderDefines m_defines;
+        uint64_t m_validMask;
+
+        // Node based, so Shader addresses stay put for hot reload.
+        std::unordered_map<uint64_t, Shader> m_variants;
+    };
+}
+
+#endif
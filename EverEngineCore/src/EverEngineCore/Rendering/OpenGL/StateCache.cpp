@@ -0,0 +1,391 @@
+#include "StateCache.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace EverEngine
+{
+    namespace
+    {
+        // Never a valid object name or enum, so it never matches a request.
+        constexpr GLuint Unknown = 0xFFFFFFFFu;
+
+        constexpr int MaxIndexedBindings = 32;
+        constexpr int MaxTextureUnits = 32;
+
+        enum BufferSlot
+        {
+            ArraySlot,
+            ElementArraySlot,
+            UniformSlot,
+            ShaderStorageSlot,
+            DrawIndirectSlot,
+            CopyReadSlot,
+            CopyWriteSlot,
+            PixelPackSlot,
+            PixelUnpackSlot,
+            BufferSlotCount
+        };
+
+        enum CapabilitySlot
+        {
+            BlendSlot,
+            DepthTestSlot,
+            CullFaceSlot,
+            ScissorTestSlot,
+            StencilTestSlot,
+            CapabilitySlotCount
+        };
+
+        struct IndexedBinding
+        {
+            GLuint buffer;
+            GLintptr offset;
+            // -1 for glBindBufferBase.
+            GLsizeiptr size;
+        };
+
+        struct TextureBinding
+        {
+            GLenum target;
+            GLuint texture;
+        };
+
+        struct State
+        {
+            GLuint program;
+            GLuint vertexArray;
+            GLuint buffers[BufferSlotCount];
+            IndexedBinding uniformBindings[MaxIndexedBindings];
+            IndexedBinding storageBindings[MaxIndexedBindings];
+
+            GLuint activeTextureUnit;
+            TextureBinding textures[MaxTextureUnits];
+
+            // -1 unknown, 0 disabled, 1 enabled.
+            int8_t capabilities[CapabilitySlotCount];
+            GLenum blendSource;
+            GLenum blendDestination;
+            GLenum depthFunc;
+            int8_t depthMask;
+
+            bool bViewportKnown;
+            GLint viewport[4];
+
+            // Starts out unknown so the first request of each kind is issued.
+            State() { reset(); }
+
+            void reset()
+            {
+                program = Unknown;
+                vertexArray = Unknown;
+                std::fill(std::begin(buffers), std::end(buffers), Unknown);
+                std::fill(std::begin(uniformBindings), std::end(uniformBindings), IndexedBinding{ Unknown, 0, 0 });
+                std::fill(std::begin(storageBindings), std::end(storageBindings), IndexedBinding{ Unknown, 0, 0 });
+
+                activeTextureUnit = Unknown;
+                std::fill(std::begin(textures), std::end(textures), TextureBinding{ Unknown, Unknown });
+
+                std::fill(std::begin(capabilities), std::end(capabilities), int8_t(-1));
+                blendSource = Unknown;
+                blendDestination = Unknown;
+                depthFunc = Unknown;
+                depthMask = -1;
+                bViewportKnown = false;
+            }
+        };
+
+        State s_state;
+        StateCacheStats s_stats;
+        StateCacheStats s_lastFrameStats;
+
+        int buffer_slot(GLenum target)
+        {
+            switch (target)
+            {
+                case GL_ARRAY_BUFFER: return ArraySlot;
+                case GL_ELEMENT_ARRAY_BUFFER: return ElementArraySlot;
+                case GL_UNIFORM_BUFFER: return UniformSlot;
+                case GL_SHADER_STORAGE_BUFFER: return ShaderStorageSlot;
+                case GL_DRAW_INDIRECT_BUFFER: return DrawIndirectSlot;
+                case GL_COPY_READ_BUFFER: return CopyReadSlot;
+                case GL_COPY_WRITE_BUFFER: return CopyWriteSlot;
+                case GL_PIXEL_PACK_BUFFER: return PixelPackSlot;
+                case GL_PIXEL_UNPACK_BUFFER: return PixelUnpackSlot;
+                default: return -1;
+            }
+        }
+
+        int capability_slot(GLenum capability)
+        {
+            switch (capability)
+            {
+                case GL_BLEND: return BlendSlot;
+                case GL_DEPTH_TEST: return DepthTestSlot;
+                case GL_CULL_FACE: return CullFaceSlot;
+                case GL_SCISSOR_TEST: return ScissorTestSlot;
+                case GL_STENCIL_TEST: return StencilTestSlot;
+                default: return -1;
+            }
+        }
+
+        IndexedBinding* indexed_binding(GLenum target, GLuint index)
+        {
+            if (index >= MaxIndexedBindings) return nullptr;
+            if (target == GL_UNIFORM_BUFFER) return &s_state.uniformBindings[index];
+            if (target == GL_SHADER_STORAGE_BUFFER) return &s_state.storageBindings[index];
+            return nullptr;
+        }
+
+        // Counts the request; true when it has to reach GL.
+        bool changed(bool bDifferent)
+        {
+            if (bDifferent)
+            {
+                ++s_stats.issued;
+            }
+            else
+            {
+                ++s_stats.elided;
+            }
+            return bDifferent;
+        }
+    }
+
+    void StateCache::use_program(GLuint program)
+    {
+        if (changed(s_state.program != program))
+        {
+            glUseProgram(program);
+            s_state.program = program;
+        }
+    }
+
+    void StateCache::bind_vertex_array(GLuint vao)
+    {
+        if (changed(s_state.vertexArray != vao))
+        {
+            glBindVertexArray(vao);
+            s_state.vertexArray = vao;
+            // The element buffer binding belongs to the VAO.
+            s_state.buffers[ElementArraySlot] = Unknown;
+        }
+    }
+
+    void StateCache::bind_buffer(GLenum target, GLuint buffer)
+    {
+        const int slot = buffer_slot(target);
+        if (slot < 0)
+        {
+            changed(true);
+            glBindBuffer(target, buffer);
+            return;
+        }
+        if (changed(s_state.buffers[slot] != buffer))
+        {
+            glBindBuffer(target, buffer);
+            s_state.buffers[slot] = buffer;
+        }
+    }
+
+    void StateCache::bind_buffer_base(GLenum target, GLuint index, GLuint buffer)
+    {
+        IndexedBinding* pBinding = indexed_binding(target, index);
+        if (!pBinding)
+        {
+            changed(true);
+            glBindBufferBase(target, index, buffer);
+        }
+        else if (changed(pBinding->buffer != buffer || pBinding->offset != 0 || pBinding->size != -1))
+        {
+            glBindBufferBase(target, index, buffer);
+            *pBinding = { buffer, 0, -1 };
+        }
+        else
+        {
+            return;
+        }
+
+        // Indexed binds also replace the generic binding.
+        const int slot = buffer_slot(target);
+        if (slot >= 0) s_state.buffers[slot] = buffer;
+    }
+
+    void StateCache::bind_buffer_range(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+    {
+        IndexedBinding* pBinding = indexed_binding(target, index);
+        if (!pBinding)
+        {
+            changed(true);
+            glBindBufferRange(target, index, buffer, offset, size);
+        }
+        else if (changed(pBinding->buffer != buffer || pBinding->offset != offset || pBinding->size != size))
+        {
+            glBindBufferRange(target, index, buffer, offset, size);
+            *pBinding = { buffer, offset, size };
+        }
+        else
+        {
+            return;
+        }
+
+        const int slot = buffer_slot(target);
+        if (slot >= 0) s_state.buffers[slot] = buffer;
+    }
+
+    void StateCache::bind_texture(GLuint unit, GLenum target, GLuint texture)
+    {
+        if (unit >= MaxTextureUnits)
+        {
+            changed(true);
+            glActiveTexture(GL_TEXTURE0 + unit);
+            glBindTexture(target, texture);
+            s_state.activeTextureUnit = unit;
+            return;
+        }
+
+        TextureBinding& binding = s_state.textures[unit];
+        if (!changed(binding.target != target || binding.texture != texture))
+        {
+            return;
+        }
+        if (s_state.activeTextureUnit != unit)
+        {
+            changed(true);
+            glActiveTexture(GL_TEXTURE0 + unit);
+            s_state.activeTextureUnit = unit;
+        }
+        glBindTexture(target, texture);
+        binding = { target, texture };
+    }
+
+    void StateCache::set_enabled(GLenum capability, bool bEnabled)
+    {
+        const int slot = capability_slot(capability);
+        if (slot >= 0 && !changed(s_state.capabilities[slot] != int8_t(bEnabled)))
+        {
+            return;
+        }
+        if (slot < 0)
+        {
+            changed(true);
+        }
+        else
+        {
+            s_state.capabilities[slot] = int8_t(bEnabled);
+        }
+
+        if (bEnabled)
+        {
+            glEnable(capability);
+        }
+        else
+        {
+            glDisable(capability);
+        }
+    }
+
+    void StateCache::set_blend_func(GLenum source, GLenum destination)
+    {
+        if (changed(s_state.blendSource != source || s_state.blendDestination != destination))
+        {
+            glBlendFunc(source, destination);
+            s_state.blendSource = source;
+            s_state.blendDestination = destination;
+        }
+    }
+
+    void StateCache::set_depth_func(GLenum func)
+    {
+        if (changed(s_state.depthFunc != func))
+        {
+            glDepthFunc(func);
+            s_state.depthFunc = func;
+        }
+    }
+
+    void StateCache::set_depth_mask(bool bWrite)
+    {
+        if (changed(s_state.depthMask != int8_t(bWrite)))
+        {
+            glDepthMask(bWrite ? GL_TRUE : GL_FALSE);
+            s_state.depthMask = int8_t(bWrite);
+        }
+    }
+
+    void StateCache::set_viewport(GLint x, GLint y, GLsizei width, GLsizei height)
+    {
+        GLint* viewport = s_state.viewport;
+        if (changed(!s_state.bViewportKnown || viewport[0] != x || viewport[1] != y ||
+            viewport[2] != width || viewport[3] != height))
+        {
+            glViewport(x, y, width, height);
+            viewport[0] = x;
+            viewport[1] = y;
+            viewport[2] = width;
+            viewport[3] = height;
+            s_state.bViewportKnown = true;
+        }
+    }
+
+    void StateCache::forget_program(GLuint program)
+    {
+        if (s_state.program == program) s_state.program = Unknown;
+    }
+
+    void StateCache::forget_vertex_array(GLuint vao)
+    {
+        if (s_state.vertexArray == vao)
+        {
+            s_state.vertexArray = Unknown;
+            s_state.buffers[ElementArraySlot] = Unknown;
+        }
+    }
+
+    void StateCache::forget_buffer(GLuint buffer)
+    {
+        for (GLuint& bound : s_state.buffers)
+        {
+            if (bound == buffer) bound = Unknown;
+        }
+        for (int i = 0; i < MaxIndexedBindings; ++i)
+        {
+            if (s_state.uniformBindings[i].buffer == buffer) s_state.uniformBindings[i].buffer = Unknown;
+            if (s_state.storageBindings[i].buffer == buffer) s_state.storageBindings[i].buffer = Unknown;
+        }
+    }
+
+    void StateCache::forget_texture(GLuint texture)
+    {
+        for (TextureBinding& binding : s_state.textures)
+        {
+            if (binding.texture == texture) binding.texture = Unknown;
+        }
+    }
+
+    void StateCache::forget_element_buffer(GLuint vao)
+    {
+        if (s_state.vertexArray == vao) s_state.buffers[ElementArraySlot] = Unknown;
+    }
+
+    void StateCache::invalidate()
+    {
+        s_state.reset();
+    }
+
+    const StateCacheStats& StateCache::get_stats()
+    {
+        return s_stats;
+    }
+
+    const StateCacheStats& StateCache::get_last_frame_stats()
+    {
+        return s_lastFrameStats;
+    }
+
+    void StateCache::end_frame()
+    {
+        s_lastFrameStats = s_stats;
+        s_stats = {};
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef STATE_CACHE_HPP
+#define STATE_CACHE_HPP
+
+#include <glad/glad.h>
+#include <cstdint>
+
+namespace EverEngine
+{
+    struct StateCacheStats
+    {
+        // GL calls made on behalf of the cache.
+        uint32_t issued = 0;
+        // Requests dropped because the state was already set.
+        uint32_t elided = 0;
+    };
+
+    // Shadow copy of the GL state the engine touches, so redundant binds and
+    // toggles never reach the driver. All engine GL code goes through here;
+    // after foreign code (ImGui, third-party renderers) changes state, call
+    // invalidate(). GL thread only.
+    class StateCache
+    {
+    public:
+        static void use_program(GLuint program);
+        static void bind_vertex_array(GLuint vao);
+
+        static void bind_buffer(GLenum target, GLuint buffer);
+        static void bind_buffer_base(GLenum target, GLuint index, GLuint buffer);
+        static void bind_buffer_range(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+
+        static void bind_texture(GLuint unit, GLenum target, GLuint texture);
+
+        static void set_enabled(GLenum capability, bool bEnabled);
+        static void set_blend_func(GLenum source, GLenum destination);
+        static void set_depth_func(GLenum func);
+        static void set_depth_mask(bool bWrite);
+        static void set_viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+        // GL unbinds deleted objects and may hand the name out again, so
+        // call these right after the matching glDelete*.
+        static void forget_program(GLuint program);
+        static void forget_vertex_array(GLuint vao);
+        static void forget_buffer(GLuint buffer);
+        static void forget_texture(GLuint texture);
+        // After a VAO's element buffer is changed without binding it (DSA).
+        static void forget_element_buffer(GLuint vao);
+
+        // Treat every tracked value as unknown; the next request of each
+        // kind is always issued.
+        static void invalidate();
+
+        // Counters for the frame in progress and the last finished one.
+        static const StateCacheStats& get_stats();
+        static const StateCacheStats& get_last_frame_stats();
+        static void end_frame();
+    };
+}
+
+#endif // STATE_CACHE_HPP
@@ -1,11 +1,104 @@
 #include "VertexBuffer.hpp"
+#include "RingBuffer.hpp"
+#include "StateCache.hpp"
+#include "EverEngineCore/Log.hpp"
+#include "EverEngineCore/Profiler.hpp"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
 namespace EverEngine
 {
+    namespace
+    {
+        // Refills an immutable buffer in place when the data fits, otherwise
+        // replaces it. Returns true when the buffer object changed.
+        bool upload_named_buffer(GLuint& buffer, size_t& capacity, const void* data, size_t size)
+        {
+            if (buffer != 0 && size <= capacity)
+            {
+                if (data && size > 0)
+                {
+                    glNamedBufferSubData(buffer, 0, size, data);
+                }
+                return false;
+            }
+
+            if (buffer != 0)
+            {
+                glDeleteBuffers(1, &buffer);
+                StateCache::forget_buffer(buffer);
+            }
+            glCreateBuffers(1, &buffer);
+            // Zero-sized storage is an error; keep one byte instead.
+            glNamedBufferStorage(buffer, std::max<size_t>(size, 1), size > 0 ? data : nullptr, GL_DYNAMIC_STORAGE_BIT);
+            capacity = size;
+            return true;
+        }
+
+        GLuint create_vertex_array()
+        {
+            GLuint vao = 0;
+            if (VertexBuffer::has_direct_state_access())
+            {
+                glCreateVertexArrays(1, &vao);
+            }
+            else
+            {
+                glGenVertexArrays(1, &vao);
+            }
+            return vao;
+        }
+
+        // Rings of the streaming VertexBuffers, advanced by end_frame().
+        std::vector<RingBuffer*> s_streams;
+
+        // A vertex array replaced mid-frame, with the ring or buffer it read.
+        // Commands queued before the swap still name them.
+        struct RetiredVertexArray
+        {
+            std::unique_ptr<RingBuffer> pRing;
+            GLuint buffer;
+            GLuint vao;
+            // Placed by the first end_frame after retiring.
+            GLsync fence;
+        };
+        std::vector<RetiredVertexArray> s_retired;
+
+        void free_retired(RetiredVertexArray& retired)
+        {
+            if (retired.fence)
+            {
+                glDeleteSync(retired.fence);
+            }
+            glDeleteVertexArrays(1, &retired.vao);
+            StateCache::forget_vertex_array(retired.vao);
+            if (retired.buffer != 0)
+            {
+                glDeleteBuffers(1, &retired.buffer);
+                StateCache::forget_buffer(retired.buffer);
+            }
+            retired.pRing.reset();
+        }
+
+        uint64_t s_lastContentId = 0;
+    }
+
     VertexBuffer::VertexBuffer()
+        : m_vao(0)
+        , m_vbo(0)
+        , m_ebo(0)
+        , m_indexCount(0)
+        , m_vertexCount(0)
+        , m_vertexBufferCapacity(0)
+        , m_indexBufferCapacity(0)
+        , m_streamOffset(0)
+        , m_bStreamCopyRead(false)
+        , m_vertexStride(0)
+        , m_baseVertex(0)
+        , m_contentId(++s_lastContentId)
     {
-        glGenVertexArrays(1, &m_vao);
+        m_vao = create_vertex_array();
     }
 
     VertexBuffer::VertexBuffer(const float* vertices, size_t vertexSize, size_t vertexCount, 
@@ -17,9 +110,7 @@ namespace EverEngine
 
     VertexBuffer::~VertexBuffer()
     {
-        if (m_vao != 0) glDeleteVertexArrays(1, &m_vao);
-        if (m_vbo != 0) glDeleteBuffers(1, &m_vbo);
-        if (m_ebo != 0) glDeleteBuffers(1, &m_ebo);
+        destroy();
     }
 
     VertexBuffer::VertexBuffer(VertexBuffer&& other) noexcept
@@ -28,145 +119,523 @@ namespace EverEngine
         , m_ebo(other.m_ebo)
         , m_indexCount(other.m_indexCount)
         , m_vertexCount(other.m_vertexCount)
+        , m_vertexBufferCapacity(other.m_vertexBufferCapacity)
+        , m_indexBufferCapacity(other.m_indexBufferCapacity)
+        , m_pStream(std::move(other.m_pStream))
+        , m_streamData(std::move(other.m_streamData))
+        , m_streamOffset(other.m_streamOffset)
+        , m_bStreamCopyRead(other.m_bStreamCopyRead)
+        , m_vertexStride(other.m_vertexStride)
+        , m_baseVertex(other.m_baseVertex)
+        , m_bindings(std::move(other.m_bindings))
+        , m_attributes(std::move(other.m_attributes))
+        , m_contentId(other.m_contentId)
     {
         other.m_vao = 0;
         other.m_vbo = 0;
         other.m_ebo = 0;
         other.m_indexCount = 0;
         other.m_vertexCount = 0;
+        other.m_baseVertex = 0;
+        other.m_contentId = ++s_lastContentId;
     }
 
     VertexBuffer& VertexBuffer::operator=(VertexBuffer&& other) noexcept
     {
         if (this != &other)
         {
-            if (m_vao != 0) glDeleteVertexArrays(1, &m_vao);
-            if (m_vbo != 0) glDeleteBuffers(1, &m_vbo);
-            if (m_ebo != 0) glDeleteBuffers(1, &m_ebo);
+            destroy();
 
             m_vao = other.m_vao;
             m_vbo = other.m_vbo;
             m_ebo = other.m_ebo;
             m_indexCount = other.m_indexCount;
             m_vertexCount = other.m_vertexCount; 
+            m_vertexBufferCapacity = other.m_vertexBufferCapacity;
+            m_indexBufferCapacity = other.m_indexBufferCapacity;
+            m_pStream = std::move(other.m_pStream);
+            m_streamData = std::move(other.m_streamData);
+            m_streamOffset = other.m_streamOffset;
+            m_bStreamCopyRead = other.m_bStreamCopyRead;
+            m_vertexStride = other.m_vertexStride;
+            m_baseVertex = other.m_baseVertex;
+            m_bindings = std::move(other.m_bindings);
+            m_attributes = std::move(other.m_attributes);
+            m_contentId = other.m_contentId;
 
             other.m_vao = 0;
             other.m_vbo = 0;
             other.m_ebo = 0;
             other.m_indexCount = 0;
             other.m_vertexCount = 0; 
+            other.m_baseVertex = 0;
+            other.m_contentId = ++s_lastContentId;
         }
         return *this;
     }
 
-    void VertexBuffer::set_data(const float* vertices, size_t vertexSize, size_t vertexCount,
-        const unsigned int* indices, size_t indexCount, BufferUsage usage)
+    void VertexBuffer::destroy()
+    {
+        if (m_vao != 0)
+        {
+            glDeleteVertexArrays(1, &m_vao);
+            StateCache::forget_vertex_array(m_vao);
+        }
+        if (m_vbo != 0)
+        {
+            glDeleteBuffers(1, &m_vbo);
+            StateCache::forget_buffer(m_vbo);
+        }
+        if (m_ebo != 0)
+        {
+            glDeleteBuffers(1, &m_ebo);
+            StateCache::forget_buffer(m_ebo);
+        }
+        if (m_pStream)
+        {
+            std::erase(s_streams, m_pStream.get());
+            m_pStream.reset();
+        }
+    }
+
+    bool VertexBuffer::has_direct_state_access()
+    {
+        return glCreateVertexArrays && glCreateBuffers && glNamedBufferStorage && glVertexArrayAttribFormat;
+    }
+
+    GLuint VertexBuffer::get_vbo() const
+    {
+        return m_pStream ? m_pStream->get_id() : m_vbo;
+    }
+
+    GLint VertexBuffer::get_base_vertex() const
+    {
+        m_bStreamCopyRead = true;
+        return m_baseVertex;
+    }
+
+    void VertexBuffer::end_frame()
+    {
+        PROFILE_SCOPE("VertexBuffer::end_frame");
+
+        for (RingBuffer* pRing : s_streams)
+        {
+            pRing->end_frame();
+            pRing->begin_frame();
+        }
+
+        std::erase_if(s_retired, [](RetiredVertexArray& retired)
+        {
+            if (!retired.fence)
+            {
+                retired.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+                return false;
+            }
+            if (glClientWaitSync(retired.fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+            {
+                return false;
+            }
+
+            free_retired(retired);
+            return true;
+        });
+    }
+
+    void VertexBuffer::release_retired()
     {
+        for (RetiredVertexArray& retired : s_retired)
+        {
+            free_retired(retired);
+        }
+        s_retired.clear();
+    }
+
+    // Copies within a frame go one after another into the frame's segment;
+    // the ring only advances in end_frame.
+    void VertexBuffer::stream_vertices(const void* data, size_t size)
+    {
+        if (!m_pStream || !m_pStream->can_allocate(size, m_vertexStride))
+        {
+            // Slack so the copy can start on a whole vertex anywhere in a segment.
+            const size_t frameSize = size + m_vertexStride;
+            const size_t grownSize = m_pStream ? std::max(frameSize, m_pStream->get_frame_size() * 2) : frameSize;
+
+            std::unique_ptr<RingBuffer> pPrevious = std::move(m_pStream);
+            const GLuint previousBuffer = m_vbo;
+            m_pStream = std::make_unique<RingBuffer>(BufferTarget::Array, grownSize);
+            s_streams.push_back(m_pStream.get());
+            m_vbo = 0;
+            m_vertexBufferCapacity = 0;
+
+            if (pPrevious || previousBuffer != 0)
+            {
+                retire_vertex_array(std::move(pPrevious), previousBuffer, m_pStream->get_id());
+            }
+            else
+            {
+                replace_buffer(0, m_pStream->get_id());
+            }
+        }
+
+        const RingAllocation allocation = m_pStream->allocate(size, m_vertexStride);
+        if (!allocation)
+        {
+            return;
+        }
+        std::memcpy(allocation.pData, data, size);
+        m_pStream->flush();
+
+        if (data != m_streamData.data())
+        {
+            const uint8_t* pBytes = static_cast<const uint8_t*>(data);
+            m_streamData.assign(pBytes, pBytes + size);
+        }
+        m_streamOffset = allocation.offset;
+        m_bStreamCopyRead = false;
+        m_baseVertex = static_cast<GLint>(allocation.offset / m_vertexStride);
+    }
+
+    void VertexBuffer::retire_vertex_array(std::unique_ptr<RingBuffer> pRing, GLuint buffer, GLuint newBuffer)
+    {
+        const GLuint oldBuffer = pRing ? pRing->get_id() : buffer;
+        if (pRing)
+        {
+            std::erase(s_streams, pRing.get());
+        }
+        s_retired.push_back({ std::move(pRing), buffer, m_vao, nullptr });
+
+        m_vao = create_vertex_array();
+        for (VertexBinding& binding : m_bindings)
+        {
+            if (binding.buffer == oldBuffer)
+            {
+                binding.buffer = newBuffer;
+            }
+        }
+        setup_vertex_array();
+    }
+
+    void VertexBuffer::setup_vertex_array()
+    {
+        if (has_direct_state_access())
+        {
+            for (size_t i = 0; i < m_bindings.size(); ++i)
+            {
+                const VertexBinding& binding = m_bindings[i];
+                glVertexArrayVertexBuffer(m_vao, static_cast<GLuint>(i), binding.buffer, binding.offset, binding.stride);
+            }
+            for (const auto& bound : m_attributes)
+            {
+                apply_attribute(bound);
+            }
+            if (m_ebo != 0)
+            {
+                glVertexArrayElementBuffer(m_vao, m_ebo);
+            }
+            return;
+        }
+
         bind();
+        if (m_ebo != 0)
+        {
+            StateCache::bind_buffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
+        }
+        for (const auto& bound : m_attributes)
+        {
+            apply_attribute(bound);
+        }
+        unbind();
+    }
 
-        if (m_vbo == 0){
-            glGenBuffers(1, &m_vbo);
+    void VertexBuffer::set_data(const float* vertices, size_t vertexSize, size_t vertexCount,
+        const unsigned int* indices, size_t indexCount, BufferUsage usage)
+    {
+        const bool bDSA = has_direct_state_access();
+        if (!bDSA)
+        {
+            bind();
         }
-        glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-        glBufferData(GL_ARRAY_BUFFER, vertexSize, vertices, static_cast<GLenum>(usage));
 
         m_vertexCount = vertexCount;
+        m_vertexStride = vertexCount > 0 ? vertexSize / vertexCount : 0;
+        m_contentId = ++s_lastContentId;
 
-        if (indices && indexCount > 0)
+        const GLuint previousBuffer = get_vbo();
+        bool bReplaced = false;
+        std::unique_ptr<RingBuffer> pPreviousStream;
+        const bool bStream = usage == BufferUsage::Stream || usage == BufferUsage::Dynamic;
+        if (bStream && vertices && m_vertexStride > 0)
+        {
+            stream_vertices(vertices, vertexSize);
+        }
+        else
         {
-            if (m_ebo == 0) {
-                glGenBuffers(1, &m_ebo);
+            pPreviousStream = std::move(m_pStream);
+            m_streamData.clear();
+            m_streamData.shrink_to_fit();
+            m_baseVertex = 0;
+
+            if (bDSA)
+            {
+                bReplaced = upload_named_buffer(m_vbo, m_vertexBufferCapacity, vertices, vertexSize);
+            }
+            else
+            {
+                if (m_vbo == 0){
+                    glGenBuffers(1, &m_vbo);
+                    bReplaced = true;
+                }
+                StateCache::bind_buffer(GL_ARRAY_BUFFER, m_vbo);
+                glBufferData(GL_ARRAY_BUFFER, vertexSize, vertices, static_cast<GLenum>(usage));
             }
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount * sizeof(unsigned int),
-                indices, static_cast<GLenum>(usage));
-            m_indexCount = indexCount;
         }
 
-        unbind();
+        if (indices && indexCount > 0)
+        {
+            set_indices(indices, indexCount, usage);
+        }
+
+        if (!bDSA)
+        {
+            unbind();
+        }
+
+        // Draws queued earlier this frame still read the streamed copy.
+        if (pPreviousStream)
+        {
+            retire_vertex_array(std::move(pPreviousStream), 0, m_vbo);
+        }
+        else if (bReplaced)
+        {
+            replace_buffer(previousBuffer, get_vbo());
+        }
     }
 
-    void VertexBuffer::set_layout(const VertexLayout& layout)
+    std::optional<VertexLayout> VertexBuffer::get_layout() const
     {
-        bind();
-        glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+        if (m_attributes.empty())
+        {
+            return std::nullopt;
+        }
 
-        size_t offset = 0;
-        for (const auto& attrib : layout.attributes)
+        const GLuint bindingIndex = m_attributes.front().binding;
+        const VertexBinding& binding = m_bindings[bindingIndex];
+        if (binding.buffer != get_vbo() || binding.offset != 0)
         {
-            glEnableVertexAttribArray(attrib.index);
-            glVertexAttribPointer(
-                attrib.index,
-                attrib.size,
-                attrib.type,
-                attrib.normalized,
-                layout.stride,
-                (void*)offset
-            );
+            return std::nullopt;
+        }
 
-            GLsizei typeSize = 0;
-            switch(attrib.type) {
-                case GL_FLOAT: typeSize = sizeof(GLfloat); break;
-                case GL_INT: typeSize = sizeof(GLint); break;
-                case GL_UNSIGNED_INT: typeSize = sizeof(GLuint); break;
-                case GL_BYTE: typeSize = sizeof(GLbyte); break;
-                case GL_UNSIGNED_BYTE: typeSize = sizeof(GLubyte); break;
-                default: typeSize = sizeof(GLfloat); break;
+        VertexLayout layout;
+        layout.stride = binding.stride;
+        for (const auto& bound : m_attributes)
+        {
+            if (bound.binding != bindingIndex)
+            {
+                return std::nullopt;
             }
-            offset += attrib.size * typeSize;
+            layout.attributes.push_back(bound.attribute);
         }
+        std::sort(layout.attributes.begin(), layout.attributes.end(),
+            [](const VertexAttribute& a, const VertexAttribute& b) { return a.index < b.index; });
+        return layout;
+    }
 
-        unbind();
+    void VertexBuffer::set_layout(const VertexLayout& layout)
+    {
+        add_vertex_buffer(get_vbo(), layout);
     }
 
+    // The whole layout reads through one binding, so on the DSA path the
+    // formats are set here once and the buffer itself is attached with a
+    // single glVertexArrayVertexBuffer.
     void VertexBuffer::add_vertex_buffer(GLuint vbo, const VertexLayout& layout)
     {
-        bind();
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-
-        size_t offset = 0;
+        const GLuint binding = find_binding(vbo, 0, layout.stride);
         for (const auto& attrib : layout.attributes)
         {
-            glEnableVertexAttribArray(attrib.index);
-            glVertexAttribPointer(
-                attrib.index, attrib.size, attrib.type,
-                attrib.normalized, layout.stride, (void*)offset
-            );
-            
-            GLsizei typeSize = 0;
-            switch(attrib.type) {
-                case GL_FLOAT: typeSize = sizeof(GLfloat); break;
-                case GL_INT: typeSize = sizeof(GLint); break;
-                case GL_UNSIGNED_INT: typeSize = sizeof(GLuint); break;
-                case GL_BYTE: typeSize = sizeof(GLbyte); break;
-                case GL_UNSIGNED_BYTE: typeSize = sizeof(GLubyte); break;
-                default: typeSize = sizeof(GLfloat); break;
-            }
-            offset += attrib.size * typeSize;
+            set_attribute(attrib, binding);
         }
-        
-        unbind();
     }
 
     void VertexBuffer::set_vertex_attrib(GLuint index, GLint size, GLenum type, 
         GLsizei stride, size_t offset)
     {
-        bind();
-        glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-        glEnableVertexAttribArray(index);
-        glVertexAttribPointer(index, size, type, GL_FALSE, stride, (void*)offset);
-        unbind();
+        // Stride 0 means tightly packed to glVertexAttribPointer but not to
+        // glVertexArrayVertexBuffer.
+        if (stride == 0)
+        {
+            stride = get_attribute_size(size, type);
+        }
+
+        // An offset inside the vertex is an interleaved attribute and shares
+        // the buffer's binding; anything further starts its own.
+        const VertexAttribute attrib = { index, size, type, false, 0 };
+        if (offset < static_cast<size_t>(stride))
+        {
+            VertexAttribute interleaved = attrib;
+            interleaved.offset = static_cast<GLuint>(offset);
+            set_attribute(interleaved, find_binding(get_vbo(), 0, stride));
+        }
+        else
+        {
+            set_attribute(attrib, find_binding(get_vbo(), static_cast<GLintptr>(offset), stride));
+        }
+    }
+
+    GLuint VertexBuffer::find_binding(GLuint buffer, GLintptr offset, GLsizei stride)
+    {
+        for (size_t i = 0; i < m_bindings.size(); ++i)
+        {
+            const VertexBinding& binding = m_bindings[i];
+            if (binding.buffer == buffer && binding.offset == offset && binding.stride == stride)
+            {
+                return static_cast<GLuint>(i);
+            }
+        }
+
+        // Reuse a binding no attribute reads through any more.
+        size_t index = 0;
+        while (index < m_bindings.size() &&
+            std::any_of(m_attributes.begin(), m_attributes.end(),
+                [index](const BoundAttribute& bound) { return bound.binding == index; }))
+        {
+            ++index;
+        }
+
+        if (index == m_bindings.size())
+        {
+            m_bindings.push_back({ buffer, offset, stride });
+        }
+        else
+        {
+            m_bindings[index] = { buffer, offset, stride };
+        }
+
+        if (has_direct_state_access())
+        {
+            glVertexArrayVertexBuffer(m_vao, static_cast<GLuint>(index), buffer, offset, stride);
+        }
+        return static_cast<GLuint>(index);
+    }
+
+    void VertexBuffer::set_attribute(const VertexAttribute& attribute, GLuint binding)
+    {
+        m_contentId = ++s_lastContentId;
+
+        auto it = std::find_if(m_attributes.begin(), m_attributes.end(),
+            [&](const BoundAttribute& bound) { return bound.attribute.index == attribute.index; });
+        if (it == m_attributes.end())
+        {
+            it = m_attributes.insert(it, { attribute, binding });
+        }
+        else
+        {
+            *it = { attribute, binding };
+        }
+
+        const bool bDSA = has_direct_state_access();
+        if (!bDSA)
+        {
+            bind();
+        }
+        apply_attribute(*it);
+        if (!bDSA)
+        {
+            unbind();
+        }
+    }
+
+    void VertexBuffer::apply_attribute(const BoundAttribute& bound) const
+    {
+        const VertexAttribute& attrib = bound.attribute;
+        if (has_direct_state_access())
+        {
+            glEnableVertexArrayAttrib(m_vao, attrib.index);
+            glVertexArrayAttribFormat(m_vao, attrib.index, attrib.size, attrib.type,
+                attrib.normalized, attrib.offset);
+            glVertexArrayAttribBinding(m_vao, attrib.index, bound.binding);
+            return;
+        }
+
+        // Pointers need a buffer; set_data points them once it has one.
+        const VertexBinding& binding = m_bindings[bound.binding];
+        if (binding.buffer == 0)
+        {
+            return;
+        }
+        StateCache::bind_buffer(GL_ARRAY_BUFFER, binding.buffer);
+        glEnableVertexAttribArray(attrib.index);
+        glVertexAttribPointer(
+            attrib.index, attrib.size, attrib.type, attrib.normalized, binding.stride,
+            (void*)(size_t(binding.offset) + attrib.offset)
+        );
+    }
+
+    void VertexBuffer::replace_buffer(GLuint oldBuffer, GLuint newBuffer)
+    {
+        if (std::none_of(m_bindings.begin(), m_bindings.end(),
+            [oldBuffer](const VertexBinding& binding) { return binding.buffer == oldBuffer; }))
+        {
+            return;
+        }
+
+        const bool bDSA = has_direct_state_access();
+        if (!bDSA)
+        {
+            bind();
+        }
+
+        for (size_t i = 0; i < m_bindings.size(); ++i)
+        {
+            VertexBinding& binding = m_bindings[i];
+            if (binding.buffer != oldBuffer)
+            {
+                continue;
+            }
+
+            binding.buffer = newBuffer;
+            if (bDSA)
+            {
+                glVertexArrayVertexBuffer(m_vao, static_cast<GLuint>(i), newBuffer, binding.offset, binding.stride);
+                continue;
+            }
+            for (const auto& bound : m_attributes)
+            {
+                if (bound.binding == i)
+                {
+                    apply_attribute(bound);
+                }
+            }
+        }
+
+        if (!bDSA)
+        {
+            unbind();
+        }
     }
 
     void VertexBuffer::set_indices(const unsigned int* indices, size_t count, BufferUsage usage)
     {
+        m_contentId = ++s_lastContentId;
+
+        if (has_direct_state_access())
+        {
+            if (upload_named_buffer(m_ebo, m_indexBufferCapacity, indices, count * sizeof(unsigned int)))
+            {
+                glVertexArrayElementBuffer(m_vao, m_ebo);
+                StateCache::forget_element_buffer(m_vao);
+            }
+            m_indexCount = count;
+            return;
+        }
+
         bind();
         
         if (m_ebo == 0) {
             glGenBuffers(1, &m_ebo);
         }
         
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
+        StateCache::bind_buffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
         glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(unsigned int), 
                     indices, static_cast<GLenum>(usage));
         m_indexCount = count;
@@ -176,51 +645,79 @@ namespace EverEngine
 
     void VertexBuffer::update_data(size_t offset, const void* data, size_t size)
     {
-        glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+        m_contentId = ++s_lastContentId;
+
+        if (m_pStream)
+        {
+            if (offset + size > m_streamData.size())
+            {
+                LOG_ERROR("ERROR::VERTEX_BUFFER::UPDATE_OUT_OF_RANGE: {} bytes at {}, buffer has {}",
+                    size, offset, m_streamData.size());
+                return;
+            }
+            std::memcpy(m_streamData.data() + offset, data, size);
+            // Patch the current copy while nothing reads it; otherwise draws
+            // already queued need it unchanged and the update gets a new one.
+            if (m_bStreamCopyRead)
+            {
+                stream_vertices(m_streamData.data(), m_streamData.size());
+            }
+            else
+            {
+                m_pStream->update(m_streamOffset + static_cast<GLintptr>(offset), data, size);
+            }
+            return;
+        }
+
+        if (has_direct_state_access())
+        {
+            glNamedBufferSubData(m_vbo, offset, size, data);
+            return;
+        }
+
+        StateCache::bind_buffer(GL_ARRAY_BUFFER, m_vbo);
         glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
     }
 
     void VertexBuffer::bind() const
     {
-        glBindVertexArray(m_vao);
+        StateCache::bind_vertex_array(m_vao);
     }
 
     void VertexBuffer::unbind() const
     {
-        glBindVertexArray(0);
+        StateCache::bind_vertex_array(0);
     }
 
     void VertexBuffer::draw(DrawMode mode) const
     {
         bind();
+        m_bStreamCopyRead = true;
 
         if (has_index_buffer())
         {
-            glDrawElements(static_cast<GLenum>(mode), m_indexCount, GL_UNSIGNED_INT, 0);
+            glDrawElementsBaseVertex(static_cast<GLenum>(mode), m_indexCount, GL_UNSIGNED_INT, 0, m_baseVertex);
         }
         else 
         {
-            glDrawArrays(static_cast<GLenum>(mode), 0, m_vertexCount);
+            glDrawArrays(static_cast<GLenum>(mode), m_baseVertex, m_vertexCount);
         }
-
-        unbind();
     }
 
     void VertexBuffer::draw_instanced(GLsizei instanceCount, DrawMode mode) const
     {
         bind();
+        m_bStreamCopyRead = true;
         
         if (has_index_buffer())
         {
-            glDrawElementsInstanced(static_cast<GLenum>(mode), m_indexCount, 
-                                GL_UNSIGNED_INT, 0, instanceCount);
+            glDrawElementsInstancedBaseVertex(static_cast<GLenum>(mode), m_indexCount, 
+                                GL_UNSIGNED_INT, 0, instanceCount, m_baseVertex);
         }
         else
         {
-            glDrawArraysInstanced(static_cast<GLenum>(mode), 0, m_vertexCount, instanceCount);
+            glDrawArraysInstanced(static_cast<GLenum>(mode), m_baseVertex, m_vertexCount, instanceCount);
         }
-        
-        unbind();
     }
 
     void VertexBuffer::set_debug_name(const std::string& name) const
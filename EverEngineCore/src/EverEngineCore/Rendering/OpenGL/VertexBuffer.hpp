@@ -5,10 +5,15 @@
 
 #include <glad/glad.h>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 namespace EverEngine
 {
+    class RingBuffer;
 
     // ========================================================================
     // Enums
@@ -34,7 +39,26 @@ namespace EverEngine
     // ========================================================================
     // VertexBuffer
     // ========================================================================
-    
+
+    // Static vertex data lives in an ordinary buffer. Stream and Dynamic data
+    // goes to a persistently mapped RingBuffer instead: each set_data writes a
+    // fresh copy after the previous ones in the frame's segment, so draws
+    // already queued keep reading theirs. Draws pick the current copy through
+    // get_base_vertex(). VertexBuffer::end_frame() fences every ring and moves
+    // it to its next segment once the frame's draws have been issued.
+    //
+    // A segment that fills up mid-frame is replaced by a ring twice the size.
+    // The vertex array changes with it (get_vao()); the old ring and array
+    // stay alive until the GPU has finished the frame that used them.
+    //
+    // With GL 4.5 / ARB_direct_state_access, buffers and attribute formats
+    // are set up through the DSA entry points and nothing is bound to edit
+    // it; static buffers use immutable storage, refilled in place while the
+    // data still fits.
+    //
+    // Attributes that read the same buffer share one vertex buffer binding.
+    // When a buffer object is replaced, every binding still reading it is
+    // pointed at the new one, whichever call set the attributes up.
     class VertexBuffer
     {
     public:
@@ -54,9 +78,32 @@ namespace EverEngine
         void add_vertex_buffer(GLuint vbo, const VertexLayout& layout);
 
         GLuint get_vao() const { return m_vao; }
+        GLuint get_vbo() const;
+        GLuint get_ebo() const { return m_ebo; }
         size_t get_index_count() const { return m_indexCount; }
         size_t get_vertex_count() const { return m_vertexCount; }
         bool has_index_buffer() const { return m_ebo != 0; }
+        // Where the current vertex data starts; non-zero only when streaming.
+        // Call it when building a draw: it tells later update_data calls that
+        // the current copy is in use and must be left alone.
+        GLint get_base_vertex() const;
+        bool is_streaming() const { return m_pStream != nullptr; }
+        // Changes with every change to the data or attributes and is never
+        // shared with another buffer, so it can key caches of the contents.
+        uint64_t get_content_id() const { return m_contentId; }
+        // The layout of the vertex data when every attribute reads it through
+        // one binding, as set_layout sets up; nullopt otherwise.
+        std::optional<VertexLayout> get_layout() const;
+
+        static bool has_direct_state_access();
+
+        // Fences and advances every streaming ring and frees the replaced
+        // ones the GPU is done with. Call once per frame, after the frame's
+        // draws have been issued.
+        static void end_frame();
+        // Frees every replaced ring and vertex array still waiting on its
+        // fence. Call before the GL context is destroyed.
+        static void release_retired();
         
         void set_debug_name(const std::string& name) const;
         void set_data(const float* vertices, size_t vertexSize, size_t vertexCount,
@@ -75,11 +122,60 @@ namespace EverEngine
         void draw_instanced(GLsizei instanceCount, DrawMode mode = DrawMode::Triangles) const;
 
     private:
+        void destroy();
+        void stream_vertices(const void* data, size_t size);
+        // Moves the vertex array aside together with the ring or buffer it
+        // read (pRing or buffer) until the GPU is done with them, and sets up
+        // a new array that reads newBuffer instead.
+        void retire_vertex_array(std::unique_ptr<RingBuffer> pRing, GLuint buffer, GLuint newBuffer);
+        // Applies every recorded binding, attribute and the index buffer.
+        void setup_vertex_array();
+
+        // A buffer the vertex array reads from; on the DSA path, one vertex
+        // buffer binding point.
+        struct VertexBinding
+        {
+            GLuint buffer;
+            GLintptr offset;
+            GLsizei stride;
+        };
+
+        // An attribute format and the binding it reads through.
+        struct BoundAttribute
+        {
+            VertexAttribute attribute;
+            GLuint binding;
+        };
+
+        GLuint find_binding(GLuint buffer, GLintptr offset, GLsizei stride);
+        void set_attribute(const VertexAttribute& attribute, GLuint binding);
+        // Expects the vertex array bound when not using DSA.
+        void apply_attribute(const BoundAttribute& bound) const;
+        // Points every binding that reads oldBuffer at newBuffer.
+        void replace_buffer(GLuint oldBuffer, GLuint newBuffer);
+
         GLuint m_vao;
         GLuint m_vbo;
         GLuint m_ebo;
         size_t m_indexCount;
         size_t m_vertexCount;
+        // Storage sizes of m_vbo and m_ebo on the DSA path.
+        size_t m_vertexBufferCapacity;
+        size_t m_indexBufferCapacity;
+
+        std::unique_ptr<RingBuffer> m_pStream;
+        // Last data written, so a partial update can write a whole new copy.
+        std::vector<uint8_t> m_streamData;
+        GLintptr m_streamOffset;
+        // Set once a draw may read the current copy; update_data then writes
+        // a new copy instead of patching this one.
+        mutable bool m_bStreamCopyRead;
+        size_t m_vertexStride;
+        GLint m_baseVertex;
+
+        std::vector<VertexBinding> m_bindings;
+        std::vector<BoundAttribute> m_attributes;
+        uint64_t m_contentId;
     };
 
 } // namespace EverEngine
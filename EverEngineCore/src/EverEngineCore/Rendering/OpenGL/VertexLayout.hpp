@@ -2,45 +2,281 @@
 #define VERTEX_LAYOUT_HPP
 
 #include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 #include <vector>
 #include <string>
 
 namespace EverEngine
 {
-    struct VertexAttribute 
+    // Bytes per component.
+    constexpr GLsizei get_vertex_type_size(GLenum type)
+    {
+        switch (type)
+        {
+            case GL_FLOAT: return sizeof(GLfloat);
+            case GL_HALF_FLOAT: return sizeof(GLhalf);
+            case GL_DOUBLE: return sizeof(GLdouble);
+            case GL_INT: return sizeof(GLint);
+            case GL_UNSIGNED_INT: return sizeof(GLuint);
+            case GL_BYTE: return sizeof(GLbyte);
+            case GL_UNSIGNED_BYTE: return sizeof(GLubyte);
+            case GL_SHORT: return sizeof(GLshort);
+            case GL_UNSIGNED_SHORT: return sizeof(GLushort);
+            default: return sizeof(GLfloat);
+        }
+    }
+
+    // Bytes per attribute; packed formats hold every component in one word.
+    constexpr GLsizei get_attribute_size(GLint size, GLenum type)
+    {
+        switch (type)
+        {
+            case GL_INT_2_10_10_10_REV:
+            case GL_UNSIGNED_INT_2_10_10_10_REV:
+            case GL_UNSIGNED_INT_10F_11F_11F_REV:
+                return sizeof(GLuint);
+            default:
+                return size * get_vertex_type_size(type);
+        }
+    }
+
+    struct VertexAttribute
     {
         GLuint index;
         GLint size;
         GLenum type;
-        bool normalized; 
+        bool normalized;
+        // Bytes from the start of the vertex.
+        GLuint offset = 0;
+
+        bool operator==(const VertexAttribute& other) const = default;
+    };
+
+    // ========================================================================
+    // Compact attribute types
+    // ========================================================================
+
+    // IEEE 754 binary16, stored as GL_HALF_FLOAT.
+    struct Half
+    {
+        uint16_t bits;
+    };
+
+    // Rounds to nearest even; out of range values become infinity.
+    constexpr Half to_half(float value)
+    {
+        const uint32_t bits = std::bit_cast<uint32_t>(value);
+        const uint32_t sign = (bits >> 16) & 0x8000u;
+        const uint32_t magnitude = bits & 0x7FFFFFFFu;
+
+        if (magnitude >= 0x7F800000u)
+        {
+            // Infinity stays infinity, NaN stays a quiet NaN.
+            return { static_cast<uint16_t>(sign | 0x7C00u | (magnitude > 0x7F800000u ? 0x200u : 0u)) };
+        }
+        if (magnitude >= 0x477FF000u)
+        {
+            return { static_cast<uint16_t>(sign | 0x7C00u) };
+        }
+        if (magnitude < 0x38800000u)
+        {
+            // Below the smallest normal half: subnormal or zero.
+            if (magnitude < 0x33000000u)
+            {
+                return { static_cast<uint16_t>(sign) };
+            }
+            const uint32_t shift = 126u - (magnitude >> 23);
+            const uint32_t mantissa = (magnitude & 0x7FFFFFu) | 0x800000u;
+            uint32_t half = mantissa >> shift;
+            const uint32_t remainder = mantissa & ((1u << shift) - 1u);
+            const uint32_t halfway = 1u << (shift - 1u);
+            if (remainder > halfway || (remainder == halfway && (half & 1u)))
+            {
+                ++half;
+            }
+            return { static_cast<uint16_t>(sign | half) };
+        }
+
+        // Rebias the exponent from 127 to 15; a rounding carry correctly
+        // spills into the exponent.
+        uint32_t half = (magnitude - 0x38000000u) >> 13;
+        const uint32_t remainder = magnitude & 0x1FFFu;
+        if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u)))
+        {
+            ++half;
+        }
+        return { static_cast<uint16_t>(sign | half) };
+    }
+
+    // N components of T; with Normalized, integers map to [0, 1] (unsigned)
+    // or [-1, 1] (signed). Integer attributes reach the shader as floats.
+    template<typename T, int N, bool Normalized = false>
+    struct VertexComponents
+    {
+        T values[N];
     };
 
+    using Half2 = VertexComponents<Half, 2>;
+    using Half4 = VertexComponents<Half, 4>;
+    using UByte4Norm = VertexComponents<uint8_t, 4, true>;
+    using Byte4Norm = VertexComponents<int8_t, 4, true>;
+    using UShort2Norm = VertexComponents<uint16_t, 2, true>;
+    using Short2Norm = VertexComponents<int16_t, 2, true>;
+
+    // Signed normalized xyz in 10 bits each and w in 2 bits
+    // (GL_INT_2_10_10_10_REV); a normal or tangent in 4 bytes.
+    struct PackedNormal
+    {
+        uint32_t bits;
+    };
+
+    constexpr PackedNormal pack_normal(float x, float y, float z, float w = 0.0f)
+    {
+        auto pack = [](float value, float scale, uint32_t mask)
+        {
+            const float clamped = value < -1.0f ? -1.0f : (value > 1.0f ? 1.0f : value);
+            const float scaled = clamped * scale;
+            const int32_t rounded = static_cast<int32_t>(scaled < 0.0f ? scaled - 0.5f : scaled + 0.5f);
+            return static_cast<uint32_t>(rounded) & mask;
+        };
+        return { pack(x, 511.0f, 0x3FFu) | (pack(y, 511.0f, 0x3FFu) << 10) |
+            (pack(z, 511.0f, 0x3FFu) << 20) | (pack(w, 1.0f, 0x3u) << 30) };
+    }
+
+    constexpr uint8_t to_unorm8(float value)
+    {
+        const float clamped = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+        return static_cast<uint8_t>(clamped * 255.0f + 0.5f);
+    }
+
+    // ========================================================================
+    // Attribute formats from C++ types
+    // ========================================================================
+
+    template<typename T>
+    constexpr GLenum get_vertex_component_type()
+    {
+        if constexpr (std::is_same_v<T, float>) return GL_FLOAT;
+        else if constexpr (std::is_same_v<T, Half>) return GL_HALF_FLOAT;
+        else if constexpr (std::is_same_v<T, int8_t>) return GL_BYTE;
+        else if constexpr (std::is_same_v<T, uint8_t>) return GL_UNSIGNED_BYTE;
+        else if constexpr (std::is_same_v<T, int16_t>) return GL_SHORT;
+        else if constexpr (std::is_same_v<T, uint16_t>) return GL_UNSIGNED_SHORT;
+        else if constexpr (std::is_same_v<T, int32_t>) return GL_INT;
+        else if constexpr (std::is_same_v<T, uint32_t>) return GL_UNSIGNED_INT;
+        else static_assert(sizeof(T) == 0, "Unsupported vertex component type");
+    }
+
+    // Size, type and normalization for a vertex member type. Unsupported
+    // member types fail to compile.
+    template<typename T>
+    struct VertexAttributeFormat;
+
+    template<>
+    struct VertexAttributeFormat<float>
+    {
+        static constexpr GLint size = 1;
+        static constexpr GLenum type = GL_FLOAT;
+        static constexpr bool normalized = false;
+    };
+
+    template<glm::length_t L, typename T, glm::qualifier Q>
+    struct VertexAttributeFormat<glm::vec<L, T, Q>>
+    {
+        static constexpr GLint size = L;
+        static constexpr GLenum type = get_vertex_component_type<T>();
+        static constexpr bool normalized = false;
+    };
+
+    template<typename T, int N, bool Normalized>
+    struct VertexAttributeFormat<VertexComponents<T, N, Normalized>>
+    {
+        static constexpr GLint size = N;
+        static constexpr GLenum type = get_vertex_component_type<T>();
+        static constexpr bool normalized = Normalized;
+    };
+
+    template<>
+    struct VertexAttributeFormat<PackedNormal>
+    {
+        static constexpr GLint size = 4;
+        static constexpr GLenum type = GL_INT_2_10_10_10_REV;
+        static constexpr bool normalized = true;
+    };
+
+    template<typename T>
+    constexpr VertexAttribute make_vertex_attribute(size_t offset)
+    {
+        using Format = VertexAttributeFormat<T>;
+        static_assert(sizeof(T) == get_attribute_size(Format::size, Format::type),
+            "Vertex member size does not match its attribute format");
+        return { 0, Format::size, Format::type, Format::normalized, static_cast<GLuint>(offset) };
+    }
+
+    #define VERTEX_ATTRIBUTE(Vertex, member) \
+        ::EverEngine::make_vertex_attribute<decltype(Vertex::member)>(offsetof(Vertex, member))
+
+    // Attributes and stride of a vertex struct, fixed at compile time.
+    // Attribute i goes to location i.
+    //     struct MeshVertex { glm::vec3 position; PackedNormal normal; Half2 uv; UByte4Norm color; };
+    //     constexpr auto MeshVertexFormat = make_vertex_format<MeshVertex>(
+    //         VERTEX_ATTRIBUTE(MeshVertex, position), VERTEX_ATTRIBUTE(MeshVertex, normal),
+    //         VERTEX_ATTRIBUTE(MeshVertex, uv), VERTEX_ATTRIBUTE(MeshVertex, color));
+    //     vb.set_layout(MeshVertexFormat);
+    template<typename Vertex, size_t N>
+    struct VertexFormat
+    {
+        static constexpr GLsizei stride = sizeof(Vertex);
+        std::array<VertexAttribute, N> attributes;
+    };
+
+    template<typename Vertex, typename... Attributes>
+    constexpr VertexFormat<Vertex, sizeof...(Attributes)> make_vertex_format(Attributes... attributes)
+    {
+        static_assert((std::is_same_v<Attributes, VertexAttribute> && ...), "Use VERTEX_ATTRIBUTE");
+
+        VertexFormat<Vertex, sizeof...(Attributes)> format{ { attributes... } };
+        for (size_t i = 0; i < format.attributes.size(); ++i)
+        {
+            format.attributes[i].index = static_cast<GLuint>(i);
+        }
+        return format;
+    }
+
+    // ========================================================================
+    // VertexLayout
+    // ========================================================================
+
     class VertexLayout
     {
     public:
         std::vector<VertexAttribute> attributes;
         GLsizei stride = 0;
 
-        void push(GLint size, GLenum type, bool normalized = GL_FALSE) 
+        VertexLayout() = default;
+
+        template<typename Vertex, size_t N>
+        VertexLayout(const VertexFormat<Vertex, N>& format)
+            : attributes(format.attributes.begin(), format.attributes.end())
+            , stride(format.stride)
         {
-            attributes.push_back({static_cast<GLuint>(attributes.size()), size, type, normalized});
-            
-            GLsizei typeSize = 0;
-            switch (type)
-            {
-                case GL_FLOAT: typeSize = sizeof(GLfloat); break;
-                case GL_INT: typeSize = sizeof(GLint); break;
-                case GL_UNSIGNED_INT: typeSize = sizeof(GLuint); break;
-                case GL_BYTE: typeSize = sizeof(GLbyte); break;
-                case GL_UNSIGNED_BYTE: typeSize = sizeof(GLubyte); break;
-                case GL_SHORT: typeSize = sizeof(GLshort); break;
-                case GL_UNSIGNED_SHORT: typeSize = sizeof(GLushort); break;
-                default: typeSize = sizeof(GLfloat); break;
-            }
+        }
 
-            stride += size * typeSize;
+        // Appends an attribute right after the previous one.
+        void push(GLint size, GLenum type, bool normalized = GL_FALSE)
+        {
+            attributes.push_back({static_cast<GLuint>(attributes.size()), size, type, normalized,
+                static_cast<GLuint>(stride)});
+            stride += get_attribute_size(size, type);
         }
+
+        bool operator==(const VertexLayout& other) const = default;
     };
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -9,6 +9,9 @@
 #include <cstring>
 #include <sstream>
 #include <iostream>
+#include <fstream>
+#include <set>
+#include <utility>
 #include "CPUinfo.hpp"
 
 // Platform-independent CPUID wrapper
@@ -73,7 +76,25 @@ CPUInfo CPUInfo::Detect() {
         }
         delete[] buffer;
     }
-#elif defined(__linux__) || defined(__APPLE__)
+#elif defined(__linux__)
+    info.logicalCores = sysconf(_SC_NPROCESSORS_ONLN);
+
+    // Unique (package, core) pairs; SMT siblings share both ids.
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::set<std::pair<int, int>> cores;
+    std::string line;
+    int physicalId = 0;
+    while (std::getline(cpuinfo, line)) {
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) continue;
+        if (line.rfind("physical id", 0) == 0) {
+            physicalId = std::stoi(line.substr(colon + 1));
+        } else if (line.rfind("core id", 0) == 0) {
+            cores.emplace(physicalId, std::stoi(line.substr(colon + 1)));
+        }
+    }
+    info.physicalCores = static_cast<uint32_t>(cores.size());
+#elif defined(__APPLE__)
     info.logicalCores = sysconf(_SC_NPROCESSORS_ONLN);
     info.physicalCores = info.logicalCores; // Approximation
 #endif
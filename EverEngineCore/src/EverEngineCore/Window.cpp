@@ -1,7 +1,11 @@
 #include "Window.hpp"
 #include "EverEngineCore/Log.hpp"
+#include "EverEngineCore/Profiler.hpp"
 #include "Rendering/OpenGL/Shader.hpp"
 #include "Rendering/OpenGL/VertexBuffer.hpp"
+#include "Rendering/OpenGL/StateCache.hpp"
+#include "Rendering/OpenGL/GeometryBatch.hpp"
+#include "Rendering/OpenGL/RendererOpenGL.hpp"
 
 
 #include <glad/glad.h>
@@ -81,6 +85,8 @@ namespace EverEngine
             return -3;
         }
 
+        Shader::init_parallel_compile((GLADloadproc)glfwGetProcAddress);
+
         glfwSetWindowUserPointer(m_pWindow, &m_data);
 
         glfwSetWindowSizeCallback(m_pWindow,
@@ -90,7 +96,7 @@ namespace EverEngine
                 data.width = width;
                 data.height = height;
 
-                data.eventCallbackFn(std::make_unique<EventWindowResize>(width, height));
+                data.eventCallbackFn(EventWindowResize(width, height));
             }
         );
 
@@ -99,7 +105,16 @@ namespace EverEngine
             {
                 WindowData& data = *static_cast<WindowData*>(glfwGetWindowUserPointer(pWindow));
 
-                data.eventCallbackFn(std::make_unique<EventMouseMoved>(x, y));
+                data.eventCallbackFn(EventMouseMoved(x, y));
+            }
+        );
+
+        glfwSetScrollCallback(m_pWindow,
+            [](GLFWwindow* pWindow, double xOffset, double yOffset)
+            {
+                WindowData& data = *static_cast<WindowData*>(glfwGetWindowUserPointer(pWindow));
+
+                data.eventCallbackFn(EventMouseWheelScroll(xOffset, yOffset));
             }
         );
 
@@ -107,14 +122,14 @@ namespace EverEngine
             [](GLFWwindow* pWindow){
                 WindowData& data = *static_cast<WindowData*>(glfwGetWindowUserPointer(pWindow));
 
-                data.eventCallbackFn(std::make_unique<EventWindowClose>());
+                data.eventCallbackFn(EventWindowClose());
             }
         );
 
         glfwSetFramebufferSizeCallback(m_pWindow, 
             [](GLFWwindow* pWindow, int width, int height)
             {
-                glViewport(0, 0, width, height);
+                StateCache::set_viewport(0, 0, width, height);
             }
         );
 
@@ -137,17 +152,31 @@ namespace EverEngine
 
     void Window::shutdown()
     {
+        // GL objects must go while the context is current, and before the
+        // statics they register with in other translation units.
+        s_vbo.reset();
+        s_shader.reset();
+        Renderer_OpenGL::shutdown();
+        VertexBuffer::release_retired();
+
         glfwDestroyWindow(m_pWindow);
         glfwTerminate();
 
     }
 
+    void Window::poll_events()
+    {
+        glfwPollEvents();
+    }
+
     void Window::on_update()
     {
+        PROFILE_SCOPE("Window::on_update");
+
         glClearColor(m_backgroundColor[0], m_backgroundColor[1], m_backgroundColor[2], m_backgroundColor[3]);
         glClear(GL_COLOR_BUFFER_BIT);
-        s_shader->use();
-        s_vbo->draw();
+        Renderer_OpenGL::draw(*s_vbo, *s_shader);
+        Renderer_OpenGL::flush();
 #ifdef ENGINE_DEBUG
         ImGuiIO& io = ImGui::GetIO();
         io.DisplaySize.x = static_cast<float>(get_width());
@@ -159,13 +188,25 @@ namespace EverEngine
 
         ImGui::Begin("BackGroundColorWindow");
         ImGui::ColorEdit4("Background Color", m_backgroundColor);
+        const StateCacheStats& stats = StateCache::get_last_frame_stats();
+        ImGui::Text("GL state calls: %u issued, %u elided", stats.issued, stats.elided);
+        const RenderQueueStats& queueStats = Renderer_OpenGL::get_queue_stats();
+        ImGui::Text("Queued draws: %u in %u draw calls (%u saved)",
+            queueStats.draws, queueStats.drawCalls, queueStats.draws - queueStats.drawCalls);
+        const AutoBatcherStats& batchStats = Renderer_OpenGL::get_batcher_stats();
+        ImGui::Text("Batched meshes: %u static, %u dynamic, %u unbatched",
+            batchStats.staticMeshes, batchStats.dynamicMeshes, batchStats.unbatched);
         ImGui::End();
 
         ImGui::Render();
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        // The backend binds its own program, buffers and textures.
+        StateCache::invalidate();
 #endif
+        StateCache::end_frame();
+        GeometryBatch::end_frame();
+        VertexBuffer::end_frame();
 
         glfwSwapBuffers(m_pWindow);
-        glfwPollEvents();
     }
 }
\ No newline at end of file
@@ -13,7 +13,7 @@ namespace EverEngine {
     class Window
     {
     public:
-        using EventCallbackFn = std::function<void(std::unique_ptr<BaseEvent>)>;
+        using EventCallbackFn = std::function<void(const Event&)>;
 
         Window(const std::string& title, const unsigned int width,
             const unsigned int height);
@@ -24,6 +24,9 @@ namespace EverEngine {
         Window& operator=(const Window&) = delete;
         Window& operator=(Window&&) = delete;
 
+        // Collects input and window events for this frame.
+        void poll_events();
+        // Renders and presents the frame.
         void on_update();
         unsigned int get_width() const 
         {
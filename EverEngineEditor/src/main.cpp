@@ -2,12 +2,18 @@
 #include <memory>
 
 #include <EverEngineCore/Application.hpp>
+#include <EverEngineCore/Profiler.hpp>
 
 class Editor : public EverEngine::Application
 {
 public:
     int frame = 0;
 
+    Editor()
+    {
+        set_frame_rate_limit(144);
+    }
+
     virtual void on_update() override 
     {
         
@@ -23,6 +29,10 @@ int main()
 
     int returnCode = editor->start(1024, 768, "Test Application class");
 
+#ifdef EVERENGINE_PROFILER_ENABLED
+    EverEngine::Profiler::write_chrome_trace("everengine_trace.json");
+#endif
+
     std::cin.get();
 
     return returnCode;
@@ -0,0 +1,77 @@
+#include <iostream>
+#include <string>
+#include <cstdlib>
+
+#include "Platform/Generic/FileSystem.hpp"
+#include "Platform/Generic/PakArchive.hpp"
+
+namespace
+{
+    void print_usage()
+    {
+        std::cout << "Usage: EverEnginePacker <input-directory> <output.pak> [--align <bytes>] [--store]\n"
+                  << "  --align <bytes>  alignment of every entry, power of two (default 16)\n"
+                  << "  --store          disable LZ4 compression\n";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3) {
+        print_usage();
+        return 1;
+    }
+
+    const std::string inputDir = argv[1];
+    const std::string outputPath = argv[2];
+
+    FileSystem::PakWriteOptions options;
+    for (int i = 3; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--store") {
+            options.compress = false;
+        } else if (arg == "--align" && i + 1 < argc) {
+            options.alignment = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+
+    if (!FileSystem::Directory::Exists(inputDir)) {
+        std::cerr << "Input directory not found: " << inputDir << std::endl;
+        return 1;
+    }
+
+    FileSystem::PakWriter writer;
+    const FileSystem::DirectoryListing listing = FileSystem::Directory::Scan(inputDir);
+    for (const FileSystem::DirectoryEntry& entry : listing) {
+        const std::string archivePath(listing.GetPath(entry));
+        writer.AddFile(archivePath, FileSystem::Path::Join(inputDir, archivePath));
+    }
+
+    if (!writer.Write(outputPath, options)) {
+        std::cerr << "Failed to write " << outputPath << std::endl;
+        return 1;
+    }
+
+    // Re-open the result, both as a sanity check and for the summary.
+    FileSystem::PakArchive archive;
+    if (!archive.Open(outputPath)) {
+        std::cerr << "Written archive failed validation: " << outputPath << std::endl;
+        return 1;
+    }
+
+    uint64_t rawSize = 0;
+    uint64_t storedSize = 0;
+    for (size_t i = 0; i < archive.GetEntryCount(); ++i) {
+        const FileSystem::PakEntry& entry = archive.GetEntry(i);
+        rawSize += entry.size;
+        storedSize += entry.storedSize;
+    }
+
+    std::cout << "Packed " << archive.GetEntryCount() << " files into " << outputPath
+              << " (" << rawSize << " -> " << storedSize << " bytes)" << std::endl;
+
+    return 0;
+}
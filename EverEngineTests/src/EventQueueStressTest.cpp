@@ -0,0 +1,108 @@
+// Several producer threads post tagged events while one consumer drains them
+// with process_events. Every event has to arrive exactly once and, per
+// producer, in the order it was posted. Run for both queue modes; the small
+// LockFree ring makes producers hit the full case constantly.
+
+#include <EverEngineCore/Event.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using namespace EverEngine;
+
+    constexpr long EventsPerRun = 200000;
+    constexpr size_t QueueCapacity = 256;
+
+    const char* get_mode_name(EventQueueMode mode)
+    {
+        return mode == EventQueueMode::LockFree ? "LockFree" : "Locked";
+    }
+
+    bool run(EventQueueMode mode, int producerCount)
+    {
+        EventDispatcher dispatcher(mode, QueueCapacity);
+        const long perProducer = EventsPerRun / producerCount;
+
+        // Producer index in x, sequence number in y.
+        std::vector<long> nextSequence(producerCount, 0);
+        long received = 0;
+        long outOfOrder = 0;
+        dispatcher.add_event_listener<EventMouseMoved>(
+            [&](EventMouseMoved& event)
+            {
+                const int producer = static_cast<int>(event.x);
+                const long sequence = static_cast<long>(event.y);
+                if (sequence != nextSequence[producer])
+                {
+                    ++outOfOrder;
+                }
+                nextSequence[producer] = sequence + 1;
+                ++received;
+            }
+        );
+
+        std::atomic<int> finished = 0;
+        std::vector<std::thread> producers;
+        for (int p = 0; p < producerCount; ++p)
+        {
+            producers.emplace_back([&, p]()
+            {
+                for (long s = 0; s < perProducer; ++s)
+                {
+                    // LockFree reports a full ring; wait for the consumer.
+                    while (!dispatcher.post_event(EventMouseMoved(static_cast<double>(p), static_cast<double>(s))))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+                ++finished;
+            });
+        }
+
+        const long expected = perProducer * producerCount;
+        while (finished.load() < producerCount || received < expected)
+        {
+            const long before = received;
+            dispatcher.process_events();
+            if (received == before)
+            {
+                // Spinning here starves producers waiting on a full ring
+                // when threads outnumber cores.
+                std::this_thread::yield();
+            }
+        }
+        for (std::thread& producer : producers)
+        {
+            producer.join();
+        }
+        dispatcher.process_events();
+
+        long missing = 0;
+        for (int p = 0; p < producerCount; ++p)
+        {
+            missing += perProducer - nextSequence[p];
+        }
+
+        const bool bPassed = received == expected && outOfOrder == 0 && missing == 0;
+        std::printf("%s %-8s producers=%2d received=%ld/%ld out_of_order=%ld missing=%ld\n",
+            bPassed ? "PASS" : "FAIL", get_mode_name(mode), producerCount, received, expected, outOfOrder, missing);
+        return bPassed;
+    }
+}
+
+int main()
+{
+    bool bPassed = true;
+    for (EventQueueMode mode : { EventQueueMode::Locked, EventQueueMode::LockFree })
+    {
+        for (int producerCount : { 1, 4, 16 })
+        {
+            bPassed &= run(mode, producerCount);
+        }
+    }
+    return bPassed ? 0 : 1;
+}